@@ -5,23 +5,24 @@
 #
 # Compiler options: CPU_${opt}_FLAGS
 # Feature support: CPU_${opt}_SUPPORTED
+#
+# Only compiler support is checked: flags are not added globally, but to the sources
+# with ISA-specific kernels. The CPU the library runs on is checked at runtime
+# (see imagestego/core/cpu.hpp), so binaries built here work on any CPU.
 
 message(STATUS "Detecting processor extensions")
 
 include("${CMAKE_CURRENT_SOURCE_DIR}/cmake/imagestego-cxx-compiler.cmake")
 
-include(CheckCXXSourceRuns)
+include(CheckCXXSourceCompiles)
 
-# function wrapper around try_run()
+# function wrapper around try_compile()
 macro(imagestego_detect_simd_support OPT)
   file(READ "${CPU_${OPT}_CHECK_FILE}" CHECK_FILE)
   set(CMAKE_REQUIRED_FLAGS "${CPU_${OPT}_FLAGS}")
-  check_cxx_source_runs("${CHECK_FILE}" CPU_${OPT}_SUPPORTED)
+  check_cxx_source_compiles("${CHECK_FILE}" CPU_${OPT}_SUPPORTED)
+  unset(CMAKE_REQUIRED_FLAGS)
   if (CPU_${OPT}_SUPPORTED)
-    string(APPEND CMAKE_CXX_FLAGS_RELEASE " ${CPU_${OPT}_FLAGS}")
-    string(APPEND CMAKE_C_FLAGS_RELEASE " ${CPU_${OPT}_FLAGS}")
-    string(APPEND CMAKE_CXX_FLAGS_DEBUG " ${CPU_${OPT}_FLAGS}")
-    string(APPEND CMAKE_C_FLAGS_DEBUG " ${CPU_${OPT}_FLAGS}")
     list(APPEND CPU_SUPPORTED_EXTENSIONS ${OPT})
   endif()
 endmacro()
@@ -83,14 +84,12 @@ if (X86 OR X86_64)
     set(CPU_AVX512BW_FLAGS "/arch:AVX512")
     set(CPU_AVX512VL_FLAGS "/arch:AVX512")
   endif()
+  imagestego_detect_simd_support(SSE2)
+  imagestego_detect_simd_support(SSSE3)
   if (NOT FORCE_SSE)
+    imagestego_detect_simd_support(AVX2)
     imagestego_detect_simd_support(AVX512BW)
     imagestego_detect_simd_support(AVX512VL)
-    imagestego_detect_simd_support(AVX2)
-  endif()
-  if (NOT CPU_AVX2_SUPPORTED)
-    imagestego_detect_simd_support(SSE2)
-    imagestego_detect_simd_support(SSSE3)
   endif()
 elseif (ARM OR AARCH64)
   set(CPU_NEON_CHECK_FILE "${CMAKE_CURRENT_SOURCE_DIR}/cmake/checks/cpu_neon.cpp")
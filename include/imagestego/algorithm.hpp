@@ -8,6 +8,7 @@
 
 #ifdef IMAGESTEGO_JPEG_SUPPORT
 #include "imagestego/algorithms/f3.hpp"
+#include "imagestego/algorithms/f5.hpp"
 #include "imagestego/algorithms/jpeg_lsb.hpp"
 #endif /* IMAGESTEGO_JPEG_SUPPORT */
 
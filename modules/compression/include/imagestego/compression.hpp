@@ -25,8 +25,14 @@
 #ifndef __IMAGESTEGO_COMPRESSION_HPP_INCLUDED__
 #define __IMAGESTEGO_COMPRESSION_HPP_INCLUDED__
 
+#include "imagestego/compression/adaptive_decoder.hpp"
+#include "imagestego/compression/adaptive_encoder.hpp"
+#include "imagestego/compression/codec.hpp"
+#include "imagestego/compression/codec_decoder.hpp"
+#include "imagestego/compression/codec_encoder.hpp"
 #include "imagestego/compression/huffman_decoder.hpp"
 #include "imagestego/compression/huffman_encoder.hpp"
+#include "imagestego/compression/huffman_mode.hpp"
 #include "imagestego/compression/lzw_decoder.hpp"
 #include "imagestego/compression/lzw_encoder.hpp"
 
@@ -0,0 +1,71 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_ADAPTIVE_DECODER_HPP_INCLUDED__
+#define __IMAGESTEGO_ADAPTIVE_DECODER_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core.hpp"
+// c++ headers
+#include <string>
+
+namespace imagestego {
+
+/**
+ * @brief Decoder for messages produced by AdaptiveEncoder.
+ */
+class IMAGESTEGO_EXPORTS AdaptiveDecoder : public Decoder {
+public:
+    /**
+     * @brief Constructs empty AdaptiveDecoder instance.
+     */
+    explicit AdaptiveDecoder() = default;
+    /**
+     * @brief Constructs AdaptiveDecoder instance with given message.
+     *
+     * @param arr Message to be decoded.
+     */
+    explicit AdaptiveDecoder(const BitArray& arr);
+    /**
+     * @brief Setter for message to be decoded.
+     *
+     * @param arr Encoded message.
+     */
+    void setMessage(const BitArray& arr) override;
+    /**
+     * @brief Getter for decoded message.
+     *
+     * @return Decoded message.
+     * @throws imagestego::Exception if message is corrupted or its codec is not
+     * available.
+     */
+    std::string getDecodedMessage() override;
+
+private:
+    BitArray _msg;
+}; // class AdaptiveDecoder
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_ADAPTIVE_DECODER_HPP_INCLUDED__ */
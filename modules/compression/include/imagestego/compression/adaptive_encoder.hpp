@@ -0,0 +1,93 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_ADAPTIVE_ENCODER_HPP_INCLUDED__
+#define __IMAGESTEGO_ADAPTIVE_ENCODER_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/compression/codec.hpp"
+#include "imagestego/core.hpp"
+// c++ headers
+#include <chrono>
+#include <string>
+
+namespace imagestego {
+
+namespace impl {
+
+class AdaptiveEncoder;
+
+} // namespace impl
+
+/**
+ * @brief Encoder choosing the codec with the smallest output.
+ *
+ * Available codecs are tried from the fastest to the slowest one until time budget
+ * is spent, Stored is always tried. Encoded message starts with codecBits-bit codec id.
+ *
+ * Budget is a soft start cutoff, not a bound on encoding time: it's checked before
+ * each codec only, so the codec started last (up to LZW, the slowest one) may run
+ * past it by its whole compression time.
+ */
+class IMAGESTEGO_EXPORTS AdaptiveEncoder : public Encoder {
+public:
+    /**
+     * @brief Constructs empty AdaptiveEncoder instance.
+     *
+     * @param budget Time after which no more codecs are started.
+     */
+    explicit AdaptiveEncoder(
+        std::chrono::microseconds budget = std::chrono::microseconds::max());
+    AdaptiveEncoder(const AdaptiveEncoder&) = delete;
+    AdaptiveEncoder& operator=(const AdaptiveEncoder&) = delete;
+    /**
+     * @brief Destructs AdaptiveEncoder.
+     */
+    virtual ~AdaptiveEncoder() noexcept;
+    /**
+     * @brief Setter for message to be encoded.
+     *
+     * @param str Message to be encoded.
+     */
+    void setMessage(const std::string& str) override;
+    /**
+     * @brief Getter for encoded message.
+     *
+     * @return Encoded message.
+     */
+    BitArray getEncodedMessage() override;
+    /**
+     * @brief Codec chosen for the last encoded message.
+     *
+     * @return Chosen codec.
+     */
+    Codec codec() const noexcept;
+
+private:
+    impl::AdaptiveEncoder* _encoder;
+}; // class AdaptiveEncoder
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_ADAPTIVE_ENCODER_HPP_INCLUDED__ */
@@ -0,0 +1,69 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_CODEC_HPP_INCLUDED__
+#define __IMAGESTEGO_CODEC_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core/config.hpp"
+// c++ headers
+#include <cstddef>
+
+namespace imagestego {
+
+/**
+ * @brief General purpose payload compressors.
+ *
+ * Deflate, Zstd and Lz4 are backed by zlib, zstd and LZ4 libraries respectively and
+ * are only available if the library was found at build time.
+ */
+enum class Codec {
+    /** Message bytes as is */
+    Stored,
+    /** Canonical Huffman code, see HuffmanEncoder */
+    Huffman,
+    /** LZW code, see LzwEncoder */
+    Lzw,
+    /** zlib stream */
+    Deflate,
+    /** zstd frame */
+    Zstd,
+    /** LZ4 block */
+    Lz4
+};
+
+/** Width of codec id AdaptiveEncoder writes in the beginning of message. */
+constexpr std::size_t codecBits = 3;
+
+/**
+ * @brief Checks if codec was compiled in.
+ *
+ * @param codec Codec to be checked.
+ * @return true if codec can be used for encoding and decoding.
+ */
+IMAGESTEGO_EXPORTS bool isCodecAvailable(Codec codec) noexcept;
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_CODEC_HPP_INCLUDED__ */
@@ -0,0 +1,80 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_CODEC_DECODER_HPP_INCLUDED__
+#define __IMAGESTEGO_CODEC_DECODER_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/compression/codec.hpp"
+#include "imagestego/core.hpp"
+// c++ headers
+#include <string>
+
+namespace imagestego {
+
+namespace impl {
+
+class CodecDecoder;
+
+} // namespace impl
+
+/**
+ * @brief Decoder for messages produced by CodecEncoder.
+ */
+class IMAGESTEGO_EXPORTS CodecDecoder : public Decoder {
+public:
+    /**
+     * @brief Constructs empty CodecDecoder instance.
+     *
+     * @param codec Codec used by encoder.
+     * @throws imagestego::Exception if codec is not available.
+     */
+    explicit CodecDecoder(Codec codec);
+    CodecDecoder(const CodecDecoder&) = delete;
+    CodecDecoder& operator=(const CodecDecoder&) = delete;
+    /**
+     * @brief Destructs CodecDecoder.
+     */
+    virtual ~CodecDecoder() noexcept;
+    /**
+     * @brief Setter for message to be decoded.
+     *
+     * @param arr Encoded message.
+     */
+    void setMessage(const BitArray& arr) override;
+    /**
+     * @brief Getter for decoded message.
+     *
+     * @return Decoded message.
+     * @throws imagestego::Exception if message is corrupted.
+     */
+    std::string getDecodedMessage() override;
+
+private:
+    impl::CodecDecoder* _decoder;
+}; // class CodecDecoder
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_CODEC_DECODER_HPP_INCLUDED__ */
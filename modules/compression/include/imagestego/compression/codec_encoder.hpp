@@ -0,0 +1,84 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_CODEC_ENCODER_HPP_INCLUDED__
+#define __IMAGESTEGO_CODEC_ENCODER_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/compression/codec.hpp"
+#include "imagestego/core.hpp"
+// c++ headers
+#include <string>
+
+namespace imagestego {
+
+namespace impl {
+
+class CodecEncoder;
+
+} // namespace impl
+
+/**
+ * @brief Encoder backed by one of general purpose codecs.
+ *
+ * Byte oriented codecs (Deflate, Zstd, Lz4) store 32-bit size of the message
+ * followed by compressed bytes.
+ */
+class IMAGESTEGO_EXPORTS CodecEncoder : public Encoder {
+public:
+    /**
+     * @brief Constructs empty CodecEncoder instance.
+     *
+     * @param codec Codec to be used.
+     * @param level Compression level, 0 stands for library default. Ignored by
+     * codecs without levels.
+     * @throws imagestego::Exception if codec is not available.
+     */
+    explicit CodecEncoder(Codec codec, int level = 0);
+    CodecEncoder(const CodecEncoder&) = delete;
+    CodecEncoder& operator=(const CodecEncoder&) = delete;
+    /**
+     * @brief Destructs CodecEncoder.
+     */
+    virtual ~CodecEncoder() noexcept;
+    /**
+     * @brief Setter for message to be encoded.
+     *
+     * @param str Message to be encoded.
+     */
+    void setMessage(const std::string& str) override;
+    /**
+     * @brief Getter for encoded message.
+     *
+     * @return Encoded message.
+     */
+    BitArray getEncodedMessage() override;
+
+private:
+    impl::CodecEncoder* _encoder;
+}; // class CodecEncoder
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_CODEC_ENCODER_HPP_INCLUDED__ */
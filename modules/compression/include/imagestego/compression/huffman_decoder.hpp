@@ -26,6 +26,7 @@
 #define __IMAGESTEGO_HUFFMAN_DECODER_HPP_INCLUDED__
 
 // imagestego headers
+#include "imagestego/compression/huffman_mode.hpp"
 #include "imagestego/core.hpp"
 // c++ headers
 #include <string>
@@ -55,6 +56,12 @@ public:
      * @param arr Message to be decoded.
      */
     explicit HuffmanDecoder(const BitArray& arr) noexcept;
+    /**
+     * @brief Constructs empty HuffmanDecoder instance with given code layout.
+     *
+     * @param mode Code layout used by encoder.
+     */
+    explicit HuffmanDecoder(HuffmanMode mode) noexcept;
     /**
      * @brief Destructs HuffmanDecoder.
      */
@@ -69,6 +76,7 @@ public:
      * @brief Getter for decoded message.
      *
      * @return Decoded message.
+     * @throws imagestego::Exception if tree of the message is corrupted.
      */
     std::string getDecodedMessage() override;
 
@@ -26,6 +26,7 @@
 #define __IMAGESTEGO_HUFFMAN_ENCODER_HPP_INCLUDED__
 
 // imagestego
+#include "imagestego/compression/huffman_mode.hpp"
 #include "imagestego/core.hpp"
 //#include "imagestego/utils/bitarray.hpp"
 // c++
@@ -58,6 +59,12 @@ public:
      */
     explicit HuffmanEncoder(const std::string& str) noexcept;
     explicit HuffmanEncoder(std::string&& str) noexcept;
+    /**
+     * @brief Constructs empty HuffmanEncoder instance with given code layout.
+     *
+     * @param mode Code layout, decoder must use the same one.
+     */
+    explicit HuffmanEncoder(HuffmanMode mode) noexcept;
     HuffmanEncoder(const HuffmanEncoder&) = delete;
     HuffmanEncoder& operator=(const HuffmanEncoder&) = delete;
     /**
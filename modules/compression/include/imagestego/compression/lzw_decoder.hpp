@@ -40,8 +40,11 @@ class LzwDecoder;
 
 /**
  * @brief Class implementing LZW decoding.
+ *
+ * Encoded message can be either set at once or fed by chunks through StreamDecoder
+ * interface.
  */
-class IMAGESTEGO_EXPORTS LzwDecoder : public Decoder {
+class IMAGESTEGO_EXPORTS LzwDecoder : public Decoder, public StreamDecoder {
 public:
     /**
      * @brief Constructs empty LzwDecoder instance.
@@ -67,8 +70,26 @@ public:
      * @brief Getter for decoded message.
      *
      * @return Decoded message.
+     * @throws imagestego::Exception if message is corrupted.
      */
     std::string getDecodedMessage() override;
+    /**
+     * @brief Decodes all complete codes of next chunk.
+     *
+     * @param arr Chunk of encoded message.
+     * @throws imagestego::Exception if message is corrupted.
+     */
+    void write(const BitArray& arr) override;
+    /**
+     * @brief Marks end of encoded message.
+     */
+    void finish() override;
+    /**
+     * @brief Takes bytes decoded since the previous call.
+     *
+     * @return Decoded bytes.
+     */
+    std::string read() override;
 
 private:
     impl::LzwDecoder* _decoder;
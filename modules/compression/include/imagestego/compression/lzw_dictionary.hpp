@@ -34,13 +34,13 @@
 namespace imagestego {
 
 struct StringElement final {
-    int prefixIndex;           // index of prefix string
-    uint8_t value;             // last byte value stored instead of string
-    int first = -1;            // index of first string which has *this as prefix
-    int left = -1, right = -1; // indexes of string which have same prefix as *this
+    int prefixIndex; // index of prefix string
+    uint8_t value;   // last byte value stored instead of string
+    uint8_t first;   // first byte of string
+    uint16_t length; // length of string
     explicit constexpr StringElement(const uint8_t val = 0,
                                      const int& prefix = -1) noexcept
-        : prefixIndex(prefix), value(val) {}
+        : prefixIndex(prefix), value(val), first(val), length(1) {}
 }; // struct StringElement
 
 class Dictionary {
@@ -53,11 +53,36 @@ public:
     virtual ~Dictionary();
 
 protected:
-    std::string at(int code);
-    void add(const uint8_t& value, const int& prefixIndex);
+    inline const StringElement& at(int code) const noexcept { return _codeTable[code]; }
+    /**
+     * Writes string backwards ending right before dst + at(code).length.
+     */
+    inline void write(int code, char* dst) const noexcept {
+        dst += _codeTable[code].length;
+        for (; code != -1; code = _codeTable[code].prefixIndex)
+            *--dst = static_cast<char>(_codeTable[code].value);
+    }
+    inline void add(const uint8_t& value, const int& prefixIndex) noexcept {
+        StringElement& s = _codeTable[_newCode++];
+        const StringElement& prefix = _codeTable[prefixIndex];
+        s.prefixIndex = prefixIndex;
+        s.value = value;
+        s.first = prefix.first;
+        s.length = static_cast<uint16_t>(prefix.length + 1);
+    }
 
 private:
+    // open-addressed table of strings keyed by (prefixIndex, value), load factor
+    // stays below 1/2; slots of previous generations are treated as empty
+    static constexpr uint8_t hashBits = maxBits + 1;
+    static constexpr uint8_t keyBits = maxBits + 9;
+    struct Slot final {
+        uint32_t tag = 0; // generation and key
+        int code = -1;
+    }; // struct Slot
     std::vector<StringElement> _codeTable;
+    std::vector<Slot> _hashTable;
+    uint32_t _generation = 1;
     unsigned int _newCode = 256;
 }; // class Dictionary
 
@@ -28,6 +28,7 @@
 // imagestego headers
 #include "imagestego/core.hpp"
 // c++ headers
+#include <cstddef>
 #include <string>
 
 namespace imagestego {
@@ -40,8 +41,10 @@ class LzwEncoder;
 
 /**
  * @brief Class implementing LZW encoding.
+ *
+ * Message can be either set at once or fed by chunks through StreamEncoder interface.
  */
-class IMAGESTEGO_EXPORTS LzwEncoder : public Encoder {
+class IMAGESTEGO_EXPORTS LzwEncoder : public Encoder, public StreamEncoder {
 public:
     /**
      * @brief Constructs empty LzwEncoder instance.
@@ -69,6 +72,23 @@ public:
      * @return Encoded message.
      */
     BitArray getEncodedMessage() override;
+    /**
+     * @brief Encodes next chunk of message.
+     *
+     * @param data Pointer to chunk.
+     * @param len Length of chunk.
+     */
+    void write(const char* data, std::size_t len) override;
+    /**
+     * @brief Flushes the last code of message.
+     */
+    void finish() override;
+    /**
+     * @brief Takes bits encoded since the previous call.
+     *
+     * @return Encoded bits.
+     */
+    BitArray read() override;
 
 private:
     impl::LzwEncoder* _encoder;
@@ -0,0 +1,75 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego
+#include "imagestego/compression/lzw_decoder.hpp"
+#include "imagestego/compression/lzw_encoder.hpp"
+// c++ headers
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+// gtest
+#include <gtest/gtest.h>
+
+namespace chrono = std::chrono;
+
+namespace {
+
+void encode(const std::string& name, const std::string& msg) {
+    imagestego::LzwEncoder encoder(msg);
+    // start
+    auto start = chrono::high_resolution_clock::now();
+    auto arr = encoder.getEncodedMessage();
+    auto end = chrono::high_resolution_clock::now();
+    // end
+    chrono::duration<double> s = end - start;
+    std::cout << name << " encoding: " << msg.size() / s.count() / (1 << 20)
+              << " MB/s, ratio " << double(arr.size()) / (8 * msg.size()) << std::endl;
+
+    imagestego::LzwDecoder decoder(arr);
+    start = chrono::high_resolution_clock::now();
+    auto decoded = decoder.getDecodedMessage();
+    end = chrono::high_resolution_clock::now();
+    s = end - start;
+    std::cout << name << " decoding: " << decoded.size() / s.count() / (1 << 20)
+              << " MB/s" << std::endl;
+    EXPECT_EQ(decoded, msg);
+}
+
+} // namespace
+
+TEST(Compression, LzwPerf) {
+    const std::size_t size = 1 << 22;
+    std::mt19937 gen(0);
+    const std::string words[] = {"the ", "quick ", "brown ", "fox ", "jumps ",
+                                 "over ", "lazy ", "dog ", "and ", "runs\n"};
+    std::string text, binary;
+    while (text.size() < size)
+        text += words[gen() % 10];
+    for (std::size_t i = 0; i != size; ++i)
+        binary += static_cast<char>(gen());
+    encode("text", text);
+    encode("binary", binary);
+}
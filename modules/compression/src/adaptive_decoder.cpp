@@ -0,0 +1,53 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/compression/adaptive_decoder.hpp"
+#include "imagestego/compression/codec_decoder.hpp"
+// c++ headers
+#include <algorithm>
+
+namespace imagestego {
+
+AdaptiveDecoder::AdaptiveDecoder(const BitArray& arr) : _msg(arr) {}
+
+void AdaptiveDecoder::setMessage(const BitArray& arr) { _msg = arr; }
+
+std::string AdaptiveDecoder::getDecodedMessage() {
+    if (_msg.size() < codecBits)
+        throw Exception(Exception::Codes::CorruptedMessage);
+    const std::size_t id = _msg.readBits(0, codecBits);
+    if (id > static_cast<std::size_t>(Codec::Lz4))
+        throw Exception(Exception::Codes::CorruptedMessage);
+    BitArray payload;
+    for (std::size_t i = codecBits; i < _msg.size(); i += 64) {
+        const std::size_t n = std::min<std::size_t>(64, _msg.size() - i);
+        payload.appendBits(_msg.readBits(i, n), n);
+    }
+    CodecDecoder decoder(static_cast<Codec>(id));
+    decoder.setMessage(payload);
+    return decoder.getDecodedMessage();
+}
+
+} // namespace imagestego
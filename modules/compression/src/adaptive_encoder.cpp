@@ -0,0 +1,99 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/compression/adaptive_encoder.hpp"
+#include "imagestego/compression/codec_encoder.hpp"
+// c++ headers
+#include <algorithm>
+#include <utility>
+
+namespace imagestego {
+
+namespace impl {
+
+class AdaptiveEncoder {
+public:
+    explicit AdaptiveEncoder(std::chrono::microseconds budget) noexcept
+        : _budget(budget) {}
+    void setMessage(const std::string& str) {
+        _msg = str;
+        _encodedMsg.clear();
+    }
+    imagestego::BitArray getEncodedMessage() {
+        if (_encodedMsg.empty())
+            encode();
+        return _encodedMsg;
+    }
+    Codec codec() const noexcept { return _codec; }
+
+private:
+    std::chrono::microseconds _budget;
+    std::string _msg;
+    imagestego::BitArray _encodedMsg;
+    Codec _codec = Codec::Stored;
+    void encode() {
+        // from the fastest to the slowest one
+        static const Codec candidates[] = {Codec::Lz4, Codec::Huffman, Codec::Zstd,
+                                           Codec::Deflate, Codec::Lzw};
+        const auto start = std::chrono::steady_clock::now();
+        _codec = Codec::Stored;
+        imagestego::BitArray best = imagestego::BitArray::fromByteString(_msg);
+        for (Codec codec : candidates) {
+            // budget only cuts off starting codecs, running one is never interrupted
+            if (std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start) >= _budget)
+                break;
+            if (!isCodecAvailable(codec))
+                continue;
+            imagestego::CodecEncoder encoder(codec);
+            encoder.setMessage(_msg);
+            imagestego::BitArray arr = encoder.getEncodedMessage();
+            if (arr.size() < best.size()) {
+                best = std::move(arr);
+                _codec = codec;
+            }
+        }
+        _encodedMsg.put(static_cast<std::size_t>(_codec), codecBits);
+        for (std::size_t i = 0; i < best.size(); i += 64) {
+            const std::size_t n = std::min<std::size_t>(64, best.size() - i);
+            _encodedMsg.appendBits(best.readBits(i, n), n);
+        }
+    }
+}; // class AdaptiveEncoder
+
+} // namespace impl
+
+AdaptiveEncoder::AdaptiveEncoder(std::chrono::microseconds budget)
+    : _encoder(new impl::AdaptiveEncoder(budget)) {}
+
+AdaptiveEncoder::~AdaptiveEncoder() noexcept { delete _encoder; }
+
+void AdaptiveEncoder::setMessage(const std::string& str) { _encoder->setMessage(str); }
+
+BitArray AdaptiveEncoder::getEncodedMessage() { return _encoder->getEncodedMessage(); }
+
+Codec AdaptiveEncoder::codec() const noexcept { return _encoder->codec(); }
+
+} // namespace imagestego
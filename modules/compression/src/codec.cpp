@@ -0,0 +1,53 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/compression/codec.hpp"
+
+namespace imagestego {
+
+bool isCodecAvailable(Codec codec) noexcept {
+    switch (codec) {
+        case Codec::Stored:
+        case Codec::Huffman:
+        case Codec::Lzw:
+            return true;
+#ifdef IMAGESTEGO_ZLIB_SUPPORT
+        case Codec::Deflate:
+            return true;
+#endif
+#ifdef IMAGESTEGO_ZSTD_SUPPORT
+        case Codec::Zstd:
+            return true;
+#endif
+#ifdef IMAGESTEGO_LZ4_SUPPORT
+        case Codec::Lz4:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+} // namespace imagestego
@@ -0,0 +1,180 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/compression/codec_decoder.hpp"
+#include "imagestego/compression/huffman_decoder.hpp"
+#include "imagestego/compression/lzw_decoder.hpp"
+// c++ headers
+#include <algorithm>
+#include <cstdint>
+// third party headers
+#ifdef IMAGESTEGO_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+#ifdef IMAGESTEGO_ZSTD_SUPPORT
+#include <zstd.h>
+#endif
+#ifdef IMAGESTEGO_LZ4_SUPPORT
+#include <lz4.h>
+#endif
+
+namespace imagestego {
+
+namespace impl {
+
+class CodecDecoder {
+public:
+    explicit CodecDecoder(Codec codec) : _codec(codec) {
+        if (!isCodecAvailable(codec))
+            throw Exception(Exception::Codes::UnsupportedCodec);
+    }
+    void setMessage(const imagestego::BitArray& arr) {
+        _msg = arr;
+        _decodedMsg.clear();
+    }
+    std::string getDecodedMessage() {
+        if (_decodedMsg.empty())
+            decode();
+        return _decodedMsg;
+    }
+
+private:
+    Codec _codec;
+    imagestego::BitArray _msg;
+    std::string _decodedMsg;
+    void decode() {
+        switch (_codec) {
+            case Codec::Stored:
+                if (_msg.size() % 8)
+                    throw Exception(Exception::Codes::CorruptedMessage);
+                _decodedMsg = _msg.toByteString();
+                return;
+            case Codec::Huffman: {
+                imagestego::HuffmanDecoder decoder(HuffmanMode::Canonical);
+                decoder.setMessage(_msg);
+                _decodedMsg = decoder.getDecodedMessage();
+                return;
+            }
+            case Codec::Lzw: {
+                imagestego::LzwDecoder decoder(_msg);
+                _decodedMsg = decoder.getDecodedMessage();
+                return;
+            }
+            default:
+                break;
+        }
+        if (_msg.size() < 32 || _msg.size() % 8)
+            throw Exception(Exception::Codes::CorruptedMessage);
+        const std::size_t size = _msg.readBits(0, 32);
+        const std::string compressed = _msg.toByteString().substr(4);
+        // stored size isn't trusted, corrupted one could allocate up to 4 GiB
+        if (size > maxSize(compressed))
+            throw Exception(Exception::Codes::CorruptedMessage);
+        _decodedMsg.resize(size);
+        if (decompress(compressed) != size)
+            throw Exception(Exception::Codes::CorruptedMessage);
+    }
+    /** upper bound of size src may be decompressed to */
+    std::size_t maxSize(const std::string& src) const {
+        switch (_codec) {
+#ifdef IMAGESTEGO_ZLIB_SUPPORT
+            case Codec::Deflate:
+                // deflate can't compress better than 1032:1
+                return src.size() * 1032;
+#endif
+#ifdef IMAGESTEGO_ZSTD_SUPPORT
+            case Codec::Zstd: {
+                // frame header holds exact size, but it's a part of untrusted payload
+                // too: every block needs at least 4 bytes (RLE block) and yields at
+                // most 128 KiB
+                const unsigned long long len =
+                    ZSTD_getFrameContentSize(src.data(), src.size());
+                if (len == ZSTD_CONTENTSIZE_UNKNOWN || len == ZSTD_CONTENTSIZE_ERROR)
+                    throw Exception(Exception::Codes::CorruptedMessage);
+                const unsigned long long bound =
+                    static_cast<unsigned long long>(src.size() / 4) << 17;
+                return static_cast<std::size_t>(std::min(len, bound));
+            }
+#endif
+#ifdef IMAGESTEGO_LZ4_SUPPORT
+            case Codec::Lz4:
+                // every input byte yields at most 255 output bytes
+                return src.size() * 255;
+#endif
+            default:
+                static_cast<void>(src);
+                throw Exception(Exception::Codes::UnsupportedCodec);
+        }
+    }
+    /** decompresses into preallocated _decodedMsg, returns decompressed size */
+    std::size_t decompress(const std::string& src) {
+        switch (_codec) {
+#ifdef IMAGESTEGO_ZLIB_SUPPORT
+            case Codec::Deflate: {
+                uLongf len = _decodedMsg.size();
+                if (uncompress(reinterpret_cast<Bytef*>(&_decodedMsg[0]), &len,
+                               reinterpret_cast<const Bytef*>(src.data()),
+                               src.size()) != Z_OK)
+                    throw Exception(Exception::Codes::CorruptedMessage);
+                return len;
+            }
+#endif
+#ifdef IMAGESTEGO_ZSTD_SUPPORT
+            case Codec::Zstd: {
+                const std::size_t len = ZSTD_decompress(
+                    &_decodedMsg[0], _decodedMsg.size(), src.data(), src.size());
+                if (ZSTD_isError(len))
+                    throw Exception(Exception::Codes::CorruptedMessage);
+                return len;
+            }
+#endif
+#ifdef IMAGESTEGO_LZ4_SUPPORT
+            case Codec::Lz4: {
+                const int len = LZ4_decompress_safe(src.data(), &_decodedMsg[0],
+                                                    static_cast<int>(src.size()),
+                                                    static_cast<int>(_decodedMsg.size()));
+                if (len < 0)
+                    throw Exception(Exception::Codes::CorruptedMessage);
+                return len;
+            }
+#endif
+            default:
+                static_cast<void>(src);
+                throw Exception(Exception::Codes::UnsupportedCodec);
+        }
+    }
+}; // class CodecDecoder
+
+} // namespace impl
+
+CodecDecoder::CodecDecoder(Codec codec) : _decoder(new impl::CodecDecoder(codec)) {}
+
+CodecDecoder::~CodecDecoder() noexcept { delete _decoder; }
+
+void CodecDecoder::setMessage(const BitArray& arr) { _decoder->setMessage(arr); }
+
+std::string CodecDecoder::getDecodedMessage() { return _decoder->getDecodedMessage(); }
+
+} // namespace imagestego
@@ -0,0 +1,148 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/compression/codec_encoder.hpp"
+#include "imagestego/compression/huffman_encoder.hpp"
+#include "imagestego/compression/lzw_encoder.hpp"
+// c++ headers
+#include <cstdint>
+#include <vector>
+// third party headers
+#ifdef IMAGESTEGO_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+#ifdef IMAGESTEGO_ZSTD_SUPPORT
+#include <zstd.h>
+#endif
+#ifdef IMAGESTEGO_LZ4_SUPPORT
+#include <lz4.h>
+#endif
+
+namespace imagestego {
+
+namespace impl {
+
+class CodecEncoder {
+public:
+    explicit CodecEncoder(Codec codec, int level) : _codec(codec), _level(level) {
+        if (!isCodecAvailable(codec))
+            throw Exception(Exception::Codes::UnsupportedCodec);
+    }
+    void setMessage(const std::string& str) {
+        _msg = str;
+        _encodedMsg.clear();
+    }
+    imagestego::BitArray getEncodedMessage() {
+        if (_encodedMsg.empty())
+            encode();
+        return _encodedMsg;
+    }
+
+private:
+    Codec _codec;
+    int _level;
+    std::string _msg;
+    imagestego::BitArray _encodedMsg;
+    void encode() {
+        switch (_codec) {
+            case Codec::Stored:
+                _encodedMsg = imagestego::BitArray::fromByteString(_msg);
+                return;
+            case Codec::Huffman: {
+                imagestego::HuffmanEncoder encoder(HuffmanMode::Canonical);
+                encoder.setMessage(_msg);
+                _encodedMsg = encoder.getEncodedMessage();
+                return;
+            }
+            case Codec::Lzw: {
+                imagestego::LzwEncoder encoder(_msg);
+                _encodedMsg = encoder.getEncodedMessage();
+                return;
+            }
+            default:
+                break;
+        }
+        const std::vector<uint8_t> compressed = compress();
+        _encodedMsg.put(_msg.size(), 32);
+        _encodedMsg.appendBytes(compressed.data(), compressed.size());
+    }
+    std::vector<uint8_t> compress() const {
+        std::vector<uint8_t> dst;
+        switch (_codec) {
+#ifdef IMAGESTEGO_ZLIB_SUPPORT
+            case Codec::Deflate: {
+                uLongf len = compressBound(_msg.size());
+                dst.resize(len);
+                if (compress2(dst.data(), &len,
+                              reinterpret_cast<const Bytef*>(_msg.data()), _msg.size(),
+                              _level ? _level : Z_DEFAULT_COMPRESSION) != Z_OK)
+                    throw Exception(Exception::Codes::InternalError);
+                dst.resize(len);
+                break;
+            }
+#endif
+#ifdef IMAGESTEGO_ZSTD_SUPPORT
+            case Codec::Zstd: {
+                // level 0 is zstd default
+                dst.resize(ZSTD_compressBound(_msg.size()));
+                const std::size_t len =
+                    ZSTD_compress(dst.data(), dst.size(), _msg.data(), _msg.size(), _level);
+                if (ZSTD_isError(len))
+                    throw Exception(Exception::Codes::InternalError);
+                dst.resize(len);
+                break;
+            }
+#endif
+#ifdef IMAGESTEGO_LZ4_SUPPORT
+            case Codec::Lz4: {
+                dst.resize(LZ4_compressBound(static_cast<int>(_msg.size())));
+                const int len = LZ4_compress_default(
+                    _msg.data(), reinterpret_cast<char*>(dst.data()),
+                    static_cast<int>(_msg.size()), static_cast<int>(dst.size()));
+                if (len <= 0)
+                    throw Exception(Exception::Codes::InternalError);
+                dst.resize(len);
+                break;
+            }
+#endif
+            default:
+                throw Exception(Exception::Codes::UnsupportedCodec);
+        }
+        return dst;
+    }
+}; // class CodecEncoder
+
+} // namespace impl
+
+CodecEncoder::CodecEncoder(Codec codec, int level)
+    : _encoder(new impl::CodecEncoder(codec, level)) {}
+
+CodecEncoder::~CodecEncoder() noexcept { delete _encoder; }
+
+void CodecEncoder::setMessage(const std::string& str) { _encoder->setMessage(str); }
+
+BitArray CodecEncoder::getEncodedMessage() { return _encoder->getEncodedMessage(); }
+
+} // namespace imagestego
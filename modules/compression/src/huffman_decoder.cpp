@@ -23,18 +23,13 @@
  */
 
 #include "imagestego/compression/huffman_decoder.hpp"
+// c++ headers
+#include <algorithm>
+#include <string>
+#include <vector>
 
 namespace imagestego {
 
-// TODO: optimize this
-unsigned char takeChar(const BitArray& arr, const std::size_t& pos) {
-    unsigned char tmp = 0;
-    for (unsigned short i = 0; i != 8; ++i) {
-        tmp |= arr[pos + i] << (7 - i);
-    }
-    return tmp;
-}
-
 namespace impl {
 
 class HuffmanDecoder {
@@ -42,117 +37,194 @@ public:
     explicit HuffmanDecoder() noexcept {}
     explicit HuffmanDecoder(const imagestego::BitArray& arr) noexcept
         : _encodedMsg(arr) {}
-    virtual ~HuffmanDecoder() noexcept {
-        if (_root)
-            delete _root;
+    explicit HuffmanDecoder(HuffmanMode mode) noexcept : _mode(mode) {}
+    virtual ~HuffmanDecoder() noexcept = default;
+    void setMessage(const imagestego::BitArray& arr) {
+        _encodedMsg = arr;
+        _tree.clear();
+        _leaves.clear();
+        _decodedMsg.clear();
     }
-    void setMessage(const imagestego::BitArray& arr) { _encodedMsg = arr; }
     std::string getDecodedMessage() {
-        if (!_root) {
-            readDfs();
-            readAlphabet();
-            createCodeTable();
+        if (_tree.empty()) {
+            if (_mode == HuffmanMode::Canonical) {
+                readCanonical();
+            } else {
+                readDfs();
+                readAlphabet();
+            }
+            createLookupTable();
             decode();
         }
         return _decodedMsg;
     }
 
 private:
+    /** Number of bits resolved by one table lookup */
+    static const int lookupBits = 10;
+    /** Maximal number of symbols stored in table entry */
+    static const int maxSymbols = 4;
+
     struct TreeNode final {
-        TreeNode* left = nullptr;
-        TreeNode* right = nullptr;
-        TreeNode* parent = nullptr;
-        explicit TreeNode(TreeNode* node = nullptr) noexcept : parent(node) {}
-        ~TreeNode() noexcept {
-            if (left)
-                delete left;
-            if (right)
-                delete right;
-        }
-    }; // TreeNode
-    static inline bool isLeftChild(TreeNode* node) {
-        if (node == nullptr)
-            return false;
-        if (node->parent == nullptr)
-            return false;
-        return node->parent->left == node;
-    }
-    static inline bool isRightChild(TreeNode* node) {
-        if (node == nullptr)
-            return false;
-        if (node->parent == nullptr)
-            return false;
-        return node->parent->right == node;
+        int left = -1;
+        int right = -1;
+        int parent = -1;
+        unsigned char symbol = 0;
+        explicit TreeNode(int parent = -1) noexcept : parent(parent) {}
+        inline bool isLeaf() const noexcept { return left < 0 && right < 0; }
+    }; // struct TreeNode
+
+    /**
+     * Result of decoding lookupBits bits starting from the root.
+     *
+     * Either holds symbols whose codes fit into lookupBits, or the node reached
+     * by a longer code, which is then finished bit by bit.
+     */
+    struct Entry final {
+        unsigned char symbols[maxSymbols];
+        /** end of the i-th symbol's code relative to lookup position */
+        uint8_t ends[maxSymbols];
+        uint8_t count = 0;
+        int node = 0;
+    }; // struct Entry
+
+    int addChild(int parent, bool right) {
+        _tree.emplace_back(parent);
+        const int child = static_cast<int>(_tree.size()) - 1;
+        if (right)
+            _tree[parent].right = child;
+        else
+            _tree[parent].left = child;
+        return child;
     }
     void readDfs() {
-        _root = new TreeNode();
-        auto currentNode = _root;
+        // 1 - go down to the left child
+        // 0 - go up to the first node without right child and create it
+        _tree.emplace_back();
+        int currentNode = 0;
         _it = 0;
-        std::string code;
+        if (_encodedMsg.empty())
+            throw Exception(Exception::Codes::CorruptedMessage);
+        if (!_encodedMsg[0]) {
+            // single symbol tree, root is a leaf
+            _leaves.assign(1, 0);
+            _it = 1;
+            return;
+        }
         do {
-            // 1 - go down
-            // 0 - up
+            // tree always ends with 0 followed by the first bit of alphabet
+            if (_it + 1 >= _encodedMsg.size())
+                throw Exception(Exception::Codes::CorruptedMessage);
             if (_encodedMsg[_it]) {
-                currentNode->left = new TreeNode(currentNode);
-                currentNode = currentNode->left;
-                code += '0';
-                if (!_encodedMsg[_it + 1]) {
-                    _codes.push_back(code);
-                }
+                currentNode = addChild(currentNode, false);
+                if (!_encodedMsg[_it + 1])
+                    _leaves.push_back(currentNode);
             } else {
-                TreeNode* cameFrom;
+                int cameFrom;
                 do {
                     cameFrom = currentNode;
-                    currentNode = currentNode->parent;
-                    code.pop_back();
-                } while (currentNode->right == cameFrom && currentNode != _root);
-                if (isLeftChild(cameFrom)) {
-                    currentNode->right = new TreeNode(currentNode);
-                    currentNode = currentNode->right;
-                    code += '1';
-                }
-                if (!_encodedMsg[_it + 1] && currentNode != _root)
-                    _codes.push_back(code);
+                    currentNode = _tree[currentNode].parent;
+                } while (_tree[currentNode].right == cameFrom && currentNode != 0);
+                if (_tree[currentNode].left == cameFrom)
+                    currentNode = addChild(currentNode, true);
+                if (!_encodedMsg[_it + 1] && currentNode != 0)
+                    _leaves.push_back(currentNode);
             }
             ++_it;
-        } while (currentNode != _root);
+        } while (currentNode != 0);
     }
     void readAlphabet() {
-        for (std::size_t i = 0; i != _codes.size(); ++i) {
-            _alphabet += takeChar(_encodedMsg, _it);
+        for (int leaf : _leaves) {
+            _tree[leaf].symbol = static_cast<unsigned char>(_encodedMsg.readBits(_it, 8));
             _it += 8;
         }
     }
-    void buildCode();
-    void createCodeTable() {
-        for (std::size_t i = 0; i != _codes.size(); ++i)
-            _codeTable.emplace(_codes[i], _alphabet[i]);
+    void readCanonical() {
+        // header: maximal length, number of codes of each length and alphabet
+        _tree.emplace_back();
+        const int maxLength = static_cast<int>(_encodedMsg.readBits(0, 4));
+        _it = 4;
+        std::vector<int> count(maxLength + 1, 0);
+        for (int len = 1; len <= maxLength; ++len) {
+            const int n = std::min(len, 8) + 1;
+            count[len] = static_cast<int>(_encodedMsg.readBits(_it, n));
+            _it += n;
+        }
+        uint32_t code = 0;
+        for (int len = 1; len <= maxLength; ++len, code <<= 1) {
+            for (int i = 0; i != count[len]; ++i, ++code) {
+                int node = 0;
+                for (int bit = len - 1; bit >= 0; --bit) {
+                    const bool right = ((code >> bit) & 1u) != 0;
+                    const int next = right ? _tree[node].right : _tree[node].left;
+                    node = (next < 0) ? addChild(node, right) : next;
+                }
+                _tree[node].symbol =
+                    static_cast<unsigned char>(_encodedMsg.readBits(_it, 8));
+                _it += 8;
+            }
+        }
+    }
+    void createLookupTable() {
+        _table.assign(std::size_t(1) << lookupBits, Entry());
+        if (_tree[0].isLeaf())
+            return;
+        for (std::size_t prefix = 0; prefix != _table.size(); ++prefix) {
+            Entry& entry = _table[prefix];
+            int node = 0;
+            for (int bit = 0; bit != lookupBits; ++bit) {
+                const bool one = ((prefix >> (lookupBits - 1 - bit)) & 1u) != 0;
+                node = one ? _tree[node].right : _tree[node].left;
+                // incomplete code, e.g. with single symbol
+                if (node < 0)
+                    break;
+                if (_tree[node].isLeaf()) {
+                    entry.symbols[entry.count] = _tree[node].symbol;
+                    entry.ends[entry.count] = static_cast<uint8_t>(bit + 1);
+                    node = 0;
+                    if (++entry.count == maxSymbols)
+                        break;
+                }
+            }
+            entry.node = node;
+        }
     }
     void decode() {
-        auto currNode = _root;
-        std::string code;
-        for (; _it != _encodedMsg.size(); ++_it) {
-            if (_encodedMsg[_it]) {
-                currNode = currNode->right;
-                code.push_back('1');
+        if (_tree[0].isLeaf())
+            return;
+        const std::size_t size = _encodedMsg.size();
+        while (_it < size) {
+            // bits past the end are read as zeros, so only complete codes are taken
+            const Entry& entry = _table[_encodedMsg.readBits(_it, lookupBits)];
+            if (entry.count) {
+                int i = 0;
+                for (; i != entry.count && _it + entry.ends[i] <= size; ++i)
+                    _decodedMsg += static_cast<char>(entry.symbols[i]);
+                if (i != entry.count)
+                    return;
+                _it += entry.ends[entry.count - 1];
             } else {
-                currNode = currNode->left;
-                code.push_back('0');
-            }
-            if (!currNode->left) {
-                _decodedMsg += _codeTable[code];
-                code.clear();
-                currNode = _root;
+                if (entry.node < 0 || _it + lookupBits >= size)
+                    return;
+                // code is longer than lookupBits
+                int node = entry.node;
+                _it += lookupBits;
+                for (; node >= 0 && !_tree[node].isLeaf() && _it != size; ++_it)
+                    node = _encodedMsg[_it] ? _tree[node].right : _tree[node].left;
+                if (node < 0 || !_tree[node].isLeaf())
+                    return;
+                _decodedMsg += static_cast<char>(_tree[node].symbol);
             }
         }
     }
-    std::unordered_map<std::string, char> _codeTable;
     imagestego::BitArray _encodedMsg;
-    std::vector<std::string> _codes;
-    std::string _alphabet;
+    std::vector<TreeNode> _tree;
+    /** leaves in DFS order, i.e. in order of alphabet */
+    std::vector<int> _leaves;
+    std::vector<Entry> _table;
     std::string _decodedMsg;
-    std::size_t _it;
-    TreeNode* _root = nullptr;
+    std::size_t _it = 0;
+    HuffmanMode _mode = HuffmanMode::Tree;
 }; // class HuffmanDecoder
 
 } // namespace impl
@@ -162,6 +234,9 @@ HuffmanDecoder::HuffmanDecoder() noexcept : decoder(new impl::HuffmanDecoder())
 HuffmanDecoder::HuffmanDecoder(const BitArray& arr) noexcept
     : decoder(new impl::HuffmanDecoder(arr)) {}
 
+HuffmanDecoder::HuffmanDecoder(HuffmanMode mode) noexcept
+    : decoder(new impl::HuffmanDecoder(mode)) {}
+
 HuffmanDecoder::~HuffmanDecoder() noexcept { delete decoder; }
 
 void HuffmanDecoder::setMessage(const BitArray& arr) { decoder->setMessage(arr); }
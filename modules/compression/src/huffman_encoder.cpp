@@ -25,8 +25,14 @@
 // imagestego headers
 #include "imagestego/compression/huffman_encoder.hpp"
 // c++ headers
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <queue>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace imagestego {
 
@@ -36,6 +42,7 @@ class HuffmanEncoder final {
 public:
     explicit HuffmanEncoder() noexcept {}
     explicit HuffmanEncoder(const std::string& str) noexcept : _msg(str) {}
+    explicit HuffmanEncoder(HuffmanMode mode) noexcept : _mode(mode) {}
     HuffmanEncoder(const HuffmanEncoder&) = delete;
     HuffmanEncoder& operator=(const HuffmanEncoder&) = delete;
     void setMessage(const std::string& str) noexcept {
@@ -43,6 +50,8 @@ public:
         _encodedMsg.clear();
     }
     imagestego::BitArray getEncodedMessage() {
+        if (_mode == HuffmanMode::Canonical)
+            return encodeCanonical();
         encode();
         return imagestego::BitArray(_encodedMsg);
     }
@@ -63,6 +72,12 @@ public:
     }
 
 private:
+    /** Maximal length of canonical code, fits into 4 bits of header */
+    static const int maxCodeLength = 15;
+
+    typedef std::array<std::size_t, 256> Histogram;
+    typedef std::array<int, 256> CodeLengths;
+
     struct TreeNode final {
         std::string data;
         bool isVisited = false;
@@ -114,6 +129,115 @@ private:
             }
         }
     }
+    /**
+     * Computes lengths of Huffman code limited to maxCodeLength bits.
+     */
+    static CodeLengths codeLengths(const Histogram& weight) {
+        CodeLengths lengths = {};
+        // leaves take indices [0, symbols.size()), inner nodes are appended after
+        // their children, so parent index is always greater than child one
+        typedef std::pair<std::size_t, int> Item;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+        std::vector<int> symbols, parent;
+        for (int s = 0; s != 256; ++s) {
+            if (weight[s]) {
+                heap.emplace(weight[s], static_cast<int>(symbols.size()));
+                symbols.push_back(s);
+                parent.push_back(-1);
+            }
+        }
+        if (symbols.size() < 2) {
+            for (int s : symbols)
+                lengths[s] = 1;
+            return lengths;
+        }
+        while (heap.size() > 1) {
+            const Item first = heap.top();
+            heap.pop();
+            const Item second = heap.top();
+            heap.pop();
+            const int node = static_cast<int>(parent.size());
+            parent.push_back(-1);
+            parent[first.second] = parent[second.second] = node;
+            heap.emplace(first.first + second.first, node);
+        }
+        std::vector<int> depth(parent.size(), 0);
+        std::vector<int> count(symbols.size() + 1, 0);
+        for (int node = static_cast<int>(parent.size()) - 2; node >= 0; --node)
+            depth[node] = depth[parent[node]] + 1;
+        for (std::size_t i = 0; i != symbols.size(); ++i)
+            ++count[depth[i]];
+        // move leaves deeper than the limit upwards keeping the code complete,
+        // see ITU T.81 K.3
+        for (int len = static_cast<int>(count.size()) - 1; len > maxCodeLength; --len) {
+            while (count[len] > 0) {
+                int j = len - 2;
+                while (count[j] == 0)
+                    --j;
+                count[len] -= 2;
+                count[len - 1] += 1;
+                count[j + 1] += 2;
+                count[j] -= 1;
+            }
+        }
+        // the most frequent symbols get the shortest codes
+        std::stable_sort(symbols.begin(), symbols.end(), [&weight](int lhs, int rhs) {
+            return weight[lhs] > weight[rhs];
+        });
+        auto it = symbols.begin();
+        for (int len = 1; len <= maxCodeLength && len < static_cast<int>(count.size());
+             ++len)
+            for (int i = 0; i != count[len]; ++i)
+                lengths[*it++] = len;
+        return lengths;
+    }
+    imagestego::BitArray encodeCanonical() const {
+        Histogram weight = {};
+        for (const char c : _msg)
+            ++weight[static_cast<unsigned char>(c)];
+        const CodeLengths lengths = codeLengths(weight);
+        // canonical order: by code length, then by symbol
+        std::vector<int> symbols;
+        for (int s = 0; s != 256; ++s)
+            if (lengths[s])
+                symbols.push_back(s);
+        std::stable_sort(symbols.begin(), symbols.end(), [&lengths](int lhs, int rhs) {
+            return lengths[lhs] < lengths[rhs];
+        });
+        const int maxLength = symbols.empty() ? 0 : lengths[symbols.back()];
+        std::array<int, maxCodeLength + 1> count = {};
+        for (int s : symbols)
+            ++count[lengths[s]];
+        // header: maximal length, number of codes of each length and alphabet
+        imagestego::BitArray arr;
+        arr.appendBits(maxLength, 4);
+        for (int len = 1; len <= maxLength; ++len)
+            arr.appendBits(count[len], std::min(len, 8) + 1);
+        std::array<uint32_t, 256> codes = {};
+        uint32_t code = 0;
+        int len = maxLength ? lengths[symbols.front()] : 0;
+        for (int s : symbols) {
+            arr.appendBits(s, 8);
+            code <<= lengths[s] - len;
+            len = lengths[s];
+            codes[s] = code++;
+        }
+        // codes are packed into 64-bit words before appending
+        uint64_t word = 0;
+        std::size_t n = 0;
+        for (const char c : _msg) {
+            const unsigned char s = static_cast<unsigned char>(c);
+            if (n + lengths[s] > 64) {
+                arr.appendBits(word, n);
+                word = 0;
+                n = 0;
+            }
+            word = (word << lengths[s]) | codes[s];
+            n += lengths[s];
+        }
+        arr.appendBits(word, n);
+        return arr;
+    }
     void dfs(TreeNode* node) {
         if (node->left) {
             _route += '1';
@@ -132,6 +256,7 @@ private:
     std::unordered_map<char, std::string> _codeTable;
     std::string _route = "";
     std::string _alphabet;
+    HuffmanMode _mode = HuffmanMode::Tree;
 }; // class HuffmanEncoderImpl
 
 } // namespace impl
@@ -144,6 +269,9 @@ HuffmanEncoder::HuffmanEncoder(const std::string& str) noexcept
 HuffmanEncoder::HuffmanEncoder(std::string&& str) noexcept
     : encoder(new impl::HuffmanEncoder(str)) {}
 
+HuffmanEncoder::HuffmanEncoder(HuffmanMode mode) noexcept
+    : encoder(new impl::HuffmanEncoder(mode)) {}
+
 void HuffmanEncoder::setMessage(const std::string& str) { encoder->setMessage(str); }
 
 BitArray HuffmanEncoder::getEncodedMessage() { return encoder->getEncodedMessage(); }
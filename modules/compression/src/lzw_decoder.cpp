@@ -24,15 +24,9 @@
 
 #include "imagestego/compression/lzw_decoder.hpp"
 #include "imagestego/compression/lzw_dictionary.hpp"
-
-std::size_t read(const imagestego::BitArray& arr, std::size_t& i, uint8_t bits) {
-    std::size_t block = 0;
-    std::size_t it;
-    for (it = i; it != i + bits; ++it)
-        block |= arr[it] << (bits - 1 - (it - i));
-    i = it;
-    return block;
-}
+// c++ headers
+#include <algorithm>
+#include <utility>
 
 namespace imagestego {
 
@@ -40,7 +34,6 @@ namespace impl {
 
 class LzwDecoder : private Dictionary {
 public:
-    static constexpr uint8_t maxBits = 12;
     explicit LzwDecoder() noexcept : Dictionary() {}
     explicit LzwDecoder(const imagestego::BitArray& arr) noexcept
         : Dictionary(), _msg(arr) {}
@@ -50,47 +43,164 @@ public:
     }
     std::string getDecodedMessage() {
         if (_decodedMsg.empty()) {
-            decode();
+            reset();
+            // every code takes at least 8 bits
+            _length = 0;
+            _output.resize(_msg.size() / 8);
+            write(_msg);
+            finish();
+            _output.resize(_length);
+            _decodedMsg.swap(_output);
+            _length = 0;
         }
         return _decodedMsg;
     }
+    void write(const imagestego::BitArray& arr) {
+        if (_finished)
+            reset();
+        // consumed bits are dropped, only unfetched tail is kept
+        if (_fetched == _size) {
+            _input = arr;
+        } else {
+            imagestego::BitArray input;
+            append(input, _input, _fetched);
+            append(input, arr, 0);
+            std::swap(input, _input);
+        }
+        _size = _input.size();
+        _fetched = 0;
+        decode();
+    }
+    void finish() noexcept { _finished = true; }
+    std::string read() {
+        std::string str(_output, 0, _length);
+        _length = 0;
+        return str;
+    }
 
 private:
     std::string _decodedMsg;
     imagestego::BitArray _msg;
+    /** decoded bytes not taken by read() yet, output grows geometrically */
+    std::string _output;
+    std::size_t _length = 0;
+    /** encoded bits not decoded yet */
+    imagestego::BitArray _input;
+    std::size_t _size = 0;
+    /** bits fetched from input but not consumed yet */
+    uint64_t _buffer = 0;
+    std::size_t _available = 0, _fetched = 0;
+    // decoding state
+    uint8_t _maxBits = 0, _bitsPerBlock = 8;
+    std::size_t _maxDictionarySize = (1 << 8), _oldCode = 0;
+    bool _blockStart = true, _finished = false;
+
+    static void append(imagestego::BitArray& dst, const imagestego::BitArray& src,
+                       std::size_t pos) {
+        for (; pos < src.size(); pos += 64) {
+            const std::size_t n = std::min<std::size_t>(64, src.size() - pos);
+            dst.appendBits(src.readBits(pos, n), n);
+        }
+    }
+    void reset() noexcept {
+        Dictionary::clear();
+        _input.clear();
+        _buffer = 0;
+        _size = _available = _fetched = 0;
+        _maxBits = 0;
+        _bitsPerBlock = 8;
+        _maxDictionarySize = (1 << _bitsPerBlock);
+        _blockStart = true;
+        _finished = false;
+    }
+    inline std::size_t remaining() const noexcept {
+        return _available + (_size - _fetched);
+    }
+    std::size_t readCode(uint8_t bits) {
+        // codes are extracted from 32-bit words instead of single bits
+        if (_available < bits) {
+            const std::size_t n = std::min<std::size_t>(32, _size - _fetched);
+            _buffer = (_buffer << n) | _input.readBits(_fetched, n);
+            _fetched += n;
+            _available += n;
+        }
+        _available -= bits;
+        return static_cast<std::size_t>((_buffer >> _available) & ((1u << bits) - 1));
+    }
+    /**
+     * Appends string of given code, strings are written from the last byte to the
+     * first one straight into output.
+     */
+    inline void append(std::size_t code) {
+        const std::size_t length = Dictionary::at(code).length;
+        reserve(length);
+        Dictionary::write(code, &_output[_length]);
+        _length += length;
+    }
+    inline void append(char c) {
+        reserve(1);
+        _output[_length++] = c;
+    }
+    inline void reserve(std::size_t n) {
+        if (_length + n > _output.size())
+            _output.resize(std::max(2 * _output.size(), _length + n));
+    }
+    /**
+     * Decodes all codes input holds enough bits for. Width of the next code is
+     * computed before checking input, so decoding resumes correctly on next chunk.
+     */
     void decode() {
-        // reading first 4 bits
-        std::size_t i = 0;
-        uint8_t maxBits = read(_msg, i, 4);
-        while (i < _msg.size()) {
-            Dictionary::clear();
-            uint8_t currentBitsPerBlock = 8;
-            std::size_t currentMaxDictionarySize = (1 << currentBitsPerBlock);
-            std::size_t code = read(_msg, i, currentBitsPerBlock);
-            _decodedMsg += static_cast<char>(code); // always 8-bit
-            std::size_t oldCode = code;
-            while (1) {
-                if (i >= _msg.size())
-                    break;
-                if (size() == currentMaxDictionarySize) {
-                    if (currentBitsPerBlock == maxBits)
-                        break;
-                    ++currentBitsPerBlock;
-                    currentMaxDictionarySize = (1 << currentBitsPerBlock);
-                }
-                code = read(_msg, i, currentBitsPerBlock);
-                std::string tmp;
+        if (!_maxBits) {
+            if (remaining() < 4)
+                return;
+            const uint8_t maxBits = static_cast<uint8_t>(readCode(4));
+            // dictionary has room for codes up to Dictionary::maxBits only
+            if (maxBits < 8 || maxBits > Dictionary::maxBits)
+                throw Exception(Exception::Codes::CorruptedMessage);
+            _maxBits = maxBits;
+        }
+        // state is kept in locals while decoding
+        uint8_t bitsPerBlock = _bitsPerBlock;
+        std::size_t maxDictionarySize = _maxDictionarySize, oldCode = _oldCode;
+        bool blockStart = _blockStart;
+        while (1) {
+            if (!blockStart && size() == maxDictionarySize) {
+                if (bitsPerBlock == _maxBits) {
+                    // dictionary is full, new block starts
+                    Dictionary::clear();
+                    bitsPerBlock = 8;
+                    blockStart = true;
+                } else
+                    ++bitsPerBlock;
+                maxDictionarySize = (1 << bitsPerBlock);
+            }
+            if (remaining() < bitsPerBlock)
+                break;
+            const std::size_t code = readCode(bitsPerBlock);
+            if (blockStart) {
+                append(static_cast<char>(code)); // always 8-bit
+                blockStart = false;
+            } else {
+                uint8_t first;
                 if (code < Dictionary::size()) {
-                    tmp = Dictionary::at(code);
-                    _decodedMsg += tmp;
+                    append(code);
+                    first = Dictionary::at(code).first;
                 } else {
-                    tmp = Dictionary::at(oldCode);
-                    _decodedMsg += tmp + tmp[0];
+                    if (code != Dictionary::size())
+                        throw Exception(Exception::Codes::CorruptedMessage);
+                    // code is being defined right now: old string + its first byte
+                    first = Dictionary::at(oldCode).first;
+                    append(oldCode);
+                    append(static_cast<char>(first));
                 }
-                Dictionary::add(tmp[0], oldCode);
-                oldCode = code;
+                Dictionary::add(first, oldCode);
             }
+            oldCode = code;
         }
+        _bitsPerBlock = bitsPerBlock;
+        _maxDictionarySize = maxDictionarySize;
+        _oldCode = oldCode;
+        _blockStart = blockStart;
     }
 }; // class LzwDecoder
 
@@ -106,4 +216,10 @@ void LzwDecoder::setMessage(const BitArray& arr) { _decoder->setMessage(arr); }
 
 std::string LzwDecoder::getDecodedMessage() { return _decoder->getDecodedMessage(); }
 
+void LzwDecoder::write(const BitArray& arr) { _decoder->write(arr); }
+
+void LzwDecoder::finish() { _decoder->finish(); }
+
+std::string LzwDecoder::read() { return _decoder->read(); }
+
 } // namespace imagestego
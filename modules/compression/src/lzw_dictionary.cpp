@@ -23,10 +23,13 @@
  */
 
 #include "imagestego/compression/lzw_dictionary.hpp"
+// c++ headers
+#include <algorithm>
 
 namespace imagestego {
 
-Dictionary::Dictionary() noexcept : _codeTable(1 << maxBits) {
+Dictionary::Dictionary() noexcept
+    : _codeTable((1 << maxBits) + 1), _hashTable(std::size_t(1) << hashBits) {
     for (unsigned int i = 0; i != 256; ++i) {
         _codeTable[i] = StringElement(i);
     }
@@ -35,57 +38,33 @@ Dictionary::Dictionary() noexcept : _codeTable(1 << maxBits) {
 Dictionary::~Dictionary() = default;
 
 void Dictionary::clear() noexcept {
-    for (unsigned int i = 0; i != 256; ++i) {
-        _codeTable[i] = StringElement(i);
-    }
     _newCode = 256;
-}
-
-std::string Dictionary::at(int index) {
-    std::string tmp;
-    while (index != -1) {
-        tmp.insert(0, 1, char(_codeTable[index].value));
-        index = _codeTable[index].prefixIndex;
+    // hash table is reset lazily, only wrapped generation requires full reset
+    if (++_generation == (uint32_t(1) << (32 - keyBits))) {
+        std::fill(_hashTable.begin(), _hashTable.end(), Slot());
+        _generation = 1;
     }
-    return tmp;
 }
 
 int Dictionary::search(const StringElement& s) {
     if (s.prefixIndex == -1)
         return s.value;
-    int index = _codeTable[s.prefixIndex].first;
-    if (index == -1) {
-        _codeTable[s.prefixIndex].first = _newCode;
-        _codeTable[_newCode++] = s;
-        return -1;
-    } else { // perform search
-        while (true) {
-            uint8_t val = _codeTable[index].value;
-            if (s.value == val)
-                return index;
-            if (s.value < val) {
-                int left = _codeTable[index].left;
-                if (left == -1) { // left insertion case
-                    _codeTable[index].left = _newCode;
-                    _codeTable[_newCode++] = s;
-                    return -1;
-                }
-                index = left;
-            } else {
-                int right = _codeTable[index].right;
-                if (right == -1) { // right insertion case
-                    _codeTable[index].right = _newCode;
-                    _codeTable[_newCode++] = s;
-                    return -1;
-                }
-                index = right;
-            }
-        } // while(1)
+    const uint32_t key = (static_cast<uint32_t>(s.prefixIndex) << 8) | s.value;
+    const uint32_t tag = (_generation << keyBits) | key;
+    const std::size_t mask = _hashTable.size() - 1;
+    // Fibonacci hashing with linear probing
+    std::size_t i = static_cast<uint32_t>(key * 2654435761u) >> (32 - hashBits);
+    for (;; i = (i + 1) & mask) {
+        Slot& slot = _hashTable[i];
+        if (slot.tag == tag)
+            return slot.code;
+        if ((slot.tag >> keyBits) != _generation) { // insertion case
+            slot.tag = tag;
+            slot.code = static_cast<int>(_newCode);
+            add(s.value, s.prefixIndex);
+            return -1;
+        }
     }
 }
 
-void Dictionary::add(const uint8_t& value, const int& prefixIndex) {
-    _codeTable[_newCode++] = StringElement(value, prefixIndex);
-}
-
 } // namespace imagestego
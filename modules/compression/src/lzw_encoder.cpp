@@ -25,6 +25,8 @@
 // imagestego headers
 #include "imagestego/compression/lzw_encoder.hpp"
 #include "imagestego/compression/lzw_dictionary.hpp"
+// c++ headers
+#include <utility>
 
 namespace imagestego {
 
@@ -39,40 +41,71 @@ public:
         _encodedMsg.clear();
     }
     imagestego::BitArray getEncodedMessage() {
-        if (_encodedMsg.empty() && _msg.size() != 1) {
-            encode();
+        if (_encodedMsg.empty()) {
+            reset();
+            _output.clear();
+            write(_msg.data(), _msg.size());
+            finish();
+            _encodedMsg = read();
         }
         return _encodedMsg;
     }
-
-private:
-    static constexpr std::size_t maxDictionarySize = (1 << maxBits) - 1;
-    std::string _msg;
-    imagestego::BitArray _encodedMsg;
-    void encode() {
-        StringElement s;
-        uint8_t currentBitsPerBlock = 8;
-        std::size_t currentMaxDictionarySize = (1 << currentBitsPerBlock);
-        _encodedMsg.put(maxBits, 4);
-        for (std::size_t i = 0; i != _msg.size(); ++i) {
-            s.value = _msg[i];
-            int index = Dictionary::search(s);
+    void write(const char* data, std::size_t len) {
+        if (_finished)
+            reset();
+        if (!_started) {
+            _output.put(maxBits, 4);
+            _started = true;
+        }
+        for (std::size_t i = 0; i != len; ++i) {
+            _s.value = static_cast<uint8_t>(data[i]);
+            int index = Dictionary::search(_s);
             if (index != -1) {
-                s.prefixIndex = index;
+                _s.prefixIndex = index;
             } else {
-                _encodedMsg.put(s.prefixIndex, currentBitsPerBlock);
-                s.prefixIndex = s.value;
-                if (Dictionary::size() > currentMaxDictionarySize) {
-                    if (currentBitsPerBlock == maxBits) {
-                        currentBitsPerBlock = 8;
+                _output.put(_s.prefixIndex, _bitsPerBlock);
+                _s.prefixIndex = _s.value;
+                if (Dictionary::size() > _maxDictionarySize) {
+                    if (_bitsPerBlock == maxBits) {
+                        _bitsPerBlock = 8;
                         Dictionary::clear();
                     } else
-                        ++currentBitsPerBlock;
-                    currentMaxDictionarySize = (1 << currentBitsPerBlock);
+                        ++_bitsPerBlock;
+                    _maxDictionarySize = (1 << _bitsPerBlock);
                 }
             }
         }
-        _encodedMsg.put(s.prefixIndex, currentBitsPerBlock);
+    }
+    void finish() {
+        if (!_started)
+            write(nullptr, 0);
+        // the last string is pending until the end of message
+        if (_s.prefixIndex != -1)
+            _output.put(_s.prefixIndex, _bitsPerBlock);
+        _finished = true;
+    }
+    imagestego::BitArray read() {
+        imagestego::BitArray bits;
+        std::swap(bits, _output);
+        return bits;
+    }
+
+private:
+    static constexpr std::size_t maxDictionarySize = (1 << maxBits) - 1;
+    std::string _msg;
+    imagestego::BitArray _encodedMsg;
+    // stream state
+    imagestego::BitArray _output;
+    StringElement _s;
+    uint8_t _bitsPerBlock = 8;
+    std::size_t _maxDictionarySize = (1 << 8);
+    bool _started = false, _finished = false;
+    void reset() {
+        Dictionary::clear();
+        _s = StringElement();
+        _bitsPerBlock = 8;
+        _maxDictionarySize = (1 << _bitsPerBlock);
+        _started = _finished = false;
     }
 }; // class LzwEncoder
 
@@ -91,4 +124,10 @@ void LzwEncoder::setMessage(const std::string& str) { _encoder->setMessage(str);
 
 BitArray LzwEncoder::getEncodedMessage() { return _encoder->getEncodedMessage(); }
 
+void LzwEncoder::write(const char* data, std::size_t len) { _encoder->write(data, len); }
+
+void LzwEncoder::finish() { _encoder->finish(); }
+
+BitArray LzwEncoder::read() { return _encoder->read(); }
+
 } // namespace imagestego
@@ -0,0 +1,104 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/compression/adaptive_decoder.hpp"
+#include "imagestego/compression/adaptive_encoder.hpp"
+#include "imagestego/compression/codec_decoder.hpp"
+#include "imagestego/compression/codec_encoder.hpp"
+// c++ headers
+#include <algorithm>
+#include <string>
+// gtest
+#include <gtest/gtest.h>
+
+using imagestego::Codec;
+
+namespace {
+
+std::string text() {
+    std::string msg;
+    for (int i = 0; i != 5000; ++i)
+        msg += "lorem ipsum dolor sit amet "[i % 27];
+    return msg;
+}
+
+} // namespace
+
+TEST(Compression, CodecEncoding) {
+    const std::string msg = text();
+    for (Codec codec : {Codec::Stored, Codec::Huffman, Codec::Lzw, Codec::Deflate,
+                        Codec::Zstd, Codec::Lz4}) {
+        if (!imagestego::isCodecAvailable(codec)) {
+            EXPECT_THROW(imagestego::CodecEncoder enc(codec), imagestego::Exception);
+            continue;
+        }
+        imagestego::CodecEncoder enc(codec);
+        enc.setMessage(msg);
+        auto arr = enc.getEncodedMessage();
+        imagestego::CodecDecoder dec(codec);
+        dec.setMessage(arr);
+        EXPECT_EQ(dec.getDecodedMessage(), msg);
+    }
+}
+
+TEST(Compression, CodecCorruptedSize) {
+    const std::string msg = text();
+    for (Codec codec : {Codec::Deflate, Codec::Zstd, Codec::Lz4}) {
+        if (!imagestego::isCodecAvailable(codec))
+            continue;
+        imagestego::CodecEncoder enc(codec);
+        enc.setMessage(msg);
+        const auto arr = enc.getEncodedMessage();
+        // stored size is replaced with the largest one, nothing is allocated for it
+        imagestego::BitArray corrupted;
+        corrupted.appendBits(0xffffffffu, 32);
+        for (std::size_t i = 32; i < arr.size(); i += 64) {
+            const std::size_t n = std::min<std::size_t>(64, arr.size() - i);
+            corrupted.appendBits(arr.readBits(i, n), n);
+        }
+        imagestego::CodecDecoder dec(codec);
+        dec.setMessage(corrupted);
+        EXPECT_THROW(dec.getDecodedMessage(), imagestego::Exception);
+    }
+}
+
+TEST(Compression, AdaptiveEncoding) {
+    const std::string msg = text();
+    imagestego::AdaptiveEncoder enc;
+    enc.setMessage(msg);
+    auto arr = enc.getEncodedMessage();
+    EXPECT_LT(arr.size(), 8 * msg.size());
+    EXPECT_NE(enc.codec(), Codec::Stored);
+    imagestego::AdaptiveDecoder dec(arr);
+    EXPECT_EQ(dec.getDecodedMessage(), msg);
+    // no budget leaves message as is
+    imagestego::AdaptiveEncoder stored(std::chrono::microseconds(0));
+    for (const std::string& str : {std::string(), std::string("a"), msg}) {
+        stored.setMessage(str);
+        dec.setMessage(stored.getEncodedMessage());
+        EXPECT_EQ(stored.codec(), Codec::Stored);
+        EXPECT_EQ(dec.getDecodedMessage(), str);
+    }
+}
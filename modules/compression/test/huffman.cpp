@@ -24,8 +24,12 @@
 
 // imagestego headers
 #include "imagestego/core/bitarray.hpp"
+#include "imagestego/core/exception.hpp"
 #include <imagestego/compression/huffman_decoder.hpp>
 #include <imagestego/compression/huffman_encoder.hpp>
+// c++ headers
+#include <random>
+#include <string>
 // gtest
 #include <gtest/gtest.h>
 
@@ -38,3 +42,73 @@ TEST(Compression, HuffmanEncoding) {
     auto str = decoder.getDecodedMessage();
     EXPECT_EQ("beep boop beer", str);
 }
+
+TEST(Compression, HuffmanLongCodes) {
+    // exponentially distributed frequencies give codes longer than lookup table
+    std::string msg;
+    for (int c = 0; c != 14; ++c)
+        msg += std::string(std::size_t(1) << c, static_cast<char>('a' + c));
+    for (std::size_t i = 0; i != 200; ++i)
+        msg += static_cast<char>(i);
+    imagestego::HuffmanEncoder encoder(msg);
+    imagestego::HuffmanDecoder decoder(encoder.getEncodedMessage());
+    EXPECT_EQ(msg, decoder.getDecodedMessage());
+
+    decoder.setMessage(imagestego::HuffmanEncoder("beep boop beer").getEncodedMessage());
+    EXPECT_EQ("beep boop beer", decoder.getDecodedMessage());
+}
+
+TEST(Compression, HuffmanCanonical) {
+    const std::string messages[] = {"beep boop beer", "", "aaaaaaa", "ab"};
+    for (const auto& msg : messages) {
+        imagestego::HuffmanEncoder encoder(imagestego::HuffmanMode::Canonical);
+        encoder.setMessage(msg);
+        imagestego::HuffmanDecoder decoder(imagestego::HuffmanMode::Canonical);
+        decoder.setMessage(encoder.getEncodedMessage());
+        EXPECT_EQ(msg, decoder.getDecodedMessage());
+    }
+    // Fibonacci frequencies make unrestricted code as long as the alphabet
+    std::string msg;
+    std::size_t a = 1, b = 1;
+    for (int c = 0; c != 24; ++c, b += a, a = b - a)
+        msg += std::string(a, static_cast<char>('A' + c));
+    for (int c = 0; c != 256; ++c)
+        msg += static_cast<char>(c);
+    imagestego::HuffmanEncoder encoder(imagestego::HuffmanMode::Canonical);
+    encoder.setMessage(msg);
+    const BitArray arr = encoder.getEncodedMessage();
+    EXPECT_LT(arr.size(), msg.size() * 8);
+    imagestego::HuffmanDecoder decoder(imagestego::HuffmanMode::Canonical);
+    decoder.setMessage(arr);
+    EXPECT_EQ(msg, decoder.getDecodedMessage());
+}
+
+TEST(Compression, HuffmanCorrupted) {
+    // truncated and random trees have to be rejected rather than read past the end
+    auto decode = [](const BitArray& arr) {
+        imagestego::HuffmanDecoder decoder(arr);
+        try {
+            decoder.getDecodedMessage();
+        } catch (const imagestego::Exception&) {
+        }
+    };
+    const BitArray arr = imagestego::HuffmanEncoder("beep boop beer").getEncodedMessage();
+    for (std::size_t size = 0; size != arr.size(); ++size) {
+        BitArray part;
+        for (std::size_t i = 0; i != size; ++i)
+            part.pushBack(arr[i]);
+        decode(part);
+    }
+    std::mt19937 gen(42);
+    for (int i = 0; i != 1000; ++i) {
+        BitArray random;
+        for (std::size_t j = gen() % 64; j != 0; --j)
+            random.pushBack(gen() % 4 != 0);
+        decode(random);
+    }
+    BitArray ones;
+    for (int i = 0; i != 16; ++i)
+        ones.pushBack(true);
+    EXPECT_THROW(imagestego::HuffmanDecoder(ones).getDecodedMessage(),
+                 imagestego::Exception);
+}
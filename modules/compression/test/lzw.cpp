@@ -24,8 +24,13 @@
 
 // imagestego headers
 #include "imagestego/core/bitarray.hpp"
+#include "imagestego/core/exception.hpp"
 #include <imagestego/compression/lzw_decoder.hpp>
 #include <imagestego/compression/lzw_encoder.hpp>
+// c++ headers
+#include <algorithm>
+#include <random>
+#include <string>
 // gtest
 #include <gtest/gtest.h>
 
@@ -37,3 +42,82 @@ TEST(Compression, LzwEncoding) {
     imagestego::LzwDecoder dec(arr);
     EXPECT_EQ(dec.getDecodedMessage(), "asdasdasdad");
 }
+
+TEST(Compression, LzwDictionaryReset) {
+    // long enough to overflow dictionary several times
+    std::string text, binary;
+    for (int i = 0; i != 20000; ++i) {
+        text += "lorem ipsum dolor sit amet "[i % 27];
+        binary += static_cast<char>((i * 7919) ^ (i >> 3));
+    }
+    for (const auto& msg : {text, binary}) {
+        imagestego::LzwEncoder enc(msg);
+        imagestego::LzwDecoder dec(enc.getEncodedMessage());
+        EXPECT_EQ(dec.getDecodedMessage(), msg);
+    }
+}
+
+TEST(Compression, LzwStreaming) {
+    std::string msg;
+    for (int i = 0; i != 30000; ++i)
+        msg += static_cast<char>("lorem ipsum dolor sit amet "[i % 27] ^ (i % 7 == 0));
+    imagestego::LzwEncoder enc(msg);
+    const auto whole = enc.getEncodedMessage();
+    // chunks of odd sizes, bits are drained after every chunk
+    BitArray arr;
+    for (std::size_t pos = 0, len = 1; pos < msg.size(); pos += len, len = 2 * len + 1) {
+        enc.write(msg.data() + pos, std::min(len, msg.size() - pos));
+        auto bits = enc.read();
+        for (std::size_t i = 0; i != bits.size(); ++i)
+            arr.pushBack(bits[i]);
+    }
+    enc.finish();
+    auto bits = enc.read();
+    for (std::size_t i = 0; i != bits.size(); ++i)
+        arr.pushBack(bits[i]);
+    EXPECT_EQ(arr.toString(), whole.toString());
+
+    imagestego::LzwDecoder dec;
+    std::string decoded;
+    for (std::size_t pos = 0, len = 3; pos < arr.size(); pos += len, len = 2 * len + 5) {
+        BitArray chunk;
+        for (std::size_t i = pos; i != std::min(pos + len, arr.size()); ++i)
+            chunk.pushBack(arr[i]);
+        dec.write(chunk);
+        decoded += dec.read();
+    }
+    dec.finish();
+    decoded += dec.read();
+    EXPECT_EQ(decoded, msg);
+    // short messages
+    for (const std::string& str : {std::string(), std::string("a")}) {
+        enc.setMessage(str);
+        dec.setMessage(enc.getEncodedMessage());
+        EXPECT_EQ(dec.getDecodedMessage(), str);
+    }
+}
+
+TEST(Compression, LzwCorrupted) {
+    // random codes have to be rejected rather than written past the dictionary
+    std::mt19937 gen(42);
+    for (int i = 0; i != 1000; ++i) {
+        BitArray arr;
+        arr.appendBits(12, 4);
+        for (std::size_t j = gen() % 4096; j != 0; --j)
+            arr.pushBack(gen() % 2 != 0);
+        imagestego::LzwDecoder dec(arr);
+        try {
+            dec.getDecodedMessage();
+        } catch (const imagestego::Exception&) {
+        }
+    }
+    BitArray arr;
+    arr.appendBits(15, 4);
+    arr.appendBits(0x61, 8);
+    EXPECT_THROW(imagestego::LzwDecoder(arr).getDecodedMessage(), imagestego::Exception);
+    arr.clear();
+    arr.appendBits(12, 4);
+    arr.appendBits(0x61, 8);
+    arr.appendBits(300, 9);
+    EXPECT_THROW(imagestego::LzwDecoder(arr).getDecodedMessage(), imagestego::Exception);
+}
@@ -26,11 +26,15 @@
 #define __IMAGESTEGO_CORE_HPP_INCLUDED__
 
 // imagestego headers
+#include "imagestego/core/batch.hpp"
 #include "imagestego/core/bitarray.hpp"
 #include "imagestego/core/config.hpp"
+#include "imagestego/core/cpu.hpp"
 #include "imagestego/core/exception.hpp"
 #include "imagestego/core/interfaces.hpp"
 #include "imagestego/core/intrinsic.hpp"
+#include "imagestego/core/permutation.hpp"
+#include "imagestego/core/thread_pool.hpp"
 
 namespace imagestego {
 
@@ -0,0 +1,153 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_CORE_BATCH_HPP_INCLUDED__
+#define __IMAGESTEGO_CORE_BATCH_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core/config.hpp"
+#include "imagestego/core/interfaces.hpp"
+// c++ headers
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace imagestego {
+
+namespace impl {
+
+class BatchEmbedder;
+
+} // namespace impl
+
+/**
+ * @brief Single embedding job.
+ */
+struct IMAGESTEGO_EXPORTS BatchJob {
+    /** Path to source image. */
+    std::string image;
+
+    /** Message to be embedded. */
+    std::string message;
+
+    /** Secret key. */
+    std::string key;
+
+    /** Path to stego container, its extension defines the format. */
+    std::string output;
+}; // struct BatchJob
+
+/**
+ * @brief Result of a single embedding job.
+ */
+struct IMAGESTEGO_EXPORTS BatchJobResult {
+    enum class Status { Ok, ReadFailed, EmbedFailed, WriteFailed };
+
+    /** Job status. */
+    Status status = Status::Ok;
+
+    /** Error description if job failed. */
+    std::string error;
+
+    /** Time spent on the job from reading to writing, in seconds. */
+    double seconds = 0;
+}; // struct BatchJobResult
+
+/**
+ * @brief Summary of batch run.
+ */
+struct IMAGESTEGO_EXPORTS BatchReport {
+    /** Per-job results in the order of jobs. */
+    std::vector<BatchJobResult> results;
+
+    /** Number of succeeded jobs. */
+    std::size_t succeeded = 0;
+
+    /** Number of failed jobs. */
+    std::size_t failed = 0;
+
+    /** Wall time of the whole batch, in seconds. */
+    double seconds = 0;
+
+    /**
+     * Number of processed jobs per second.
+     *
+     * @return Throughput.
+     */
+    inline double throughput() const noexcept {
+        return (seconds > 0) ? static_cast<double>(results.size()) / seconds : 0;
+    }
+}; // struct BatchReport
+
+/**
+ * @brief Embeds messages into many images concurrently.
+ *
+ * Reading, embedding and writing form a pipeline: the calling thread reads images,
+ * worker threads of a work-stealing pool embed via in-memory API and a writer thread
+ * stores containers. Every worker reuses its own embedder across jobs.
+ */
+class IMAGESTEGO_EXPORTS BatchEmbedder {
+public:
+    /**
+     * Embedder factory type definition.
+     */
+    typedef std::function<StegoEmbedder*()> Factory;
+
+    /**
+     * Constructs batch embedder.
+     *
+     * @param factory Factory creating embedders, called once per worker.
+     * @param threads Number of workers, 0 means number of hardware threads.
+     * @param maxInFlight Maximal number of images held in memory, 0 means twice the
+     * number of workers.
+     */
+    explicit BatchEmbedder(Factory factory, std::size_t threads = 0,
+                           std::size_t maxInFlight = 0);
+
+    /**
+     * imagestego::BatchEmbedder destructor.
+     */
+    virtual ~BatchEmbedder() noexcept;
+
+    BatchEmbedder(const BatchEmbedder&) = delete;
+    BatchEmbedder& operator=(const BatchEmbedder&) = delete;
+
+    /**
+     * Runs jobs.
+     *
+     * Failure of a job doesn't stop the others, it is reported instead.
+     *
+     * @param jobs Jobs to be run.
+     * @return Report with per-job status and throughput.
+     */
+    BatchReport run(const std::vector<BatchJob>& jobs);
+
+private:
+    /** Pointer to implementation. */
+    impl::BatchEmbedder* _pImpl;
+}; // class BatchEmbedder
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_CORE_BATCH_HPP_INCLUDED__ */
@@ -65,6 +65,11 @@ public:
      */
     typedef typename impl::BitArray::iterator iterator;
 
+    /**
+     * Block view type definition.
+     */
+    typedef typename impl::BitArray::BlockView BlockView;
+
     /**
      * @brief Bit array constructor.
      *
@@ -179,6 +184,42 @@ public:
      */
     void put(std::size_t num, std::size_t n);
 
+    /**
+     * Appends n lowest bits of number, most significant first.
+     *
+     * @param bits Number from which bits are taken.
+     * @param n Number of bits to append, at most 64.
+     */
+    void appendBits(uint64_t bits, std::size_t n);
+
+    /**
+     * Appends bytes to the array.
+     *
+     * @param data Pointer to bytes.
+     * @param len Number of bytes.
+     */
+    void appendBytes(const uint8_t* data, std::size_t len);
+
+    /**
+     * Reads n bits starting from given position.
+     *
+     * Bits past the end of array are read as zeros.
+     *
+     * @param pos Position of the first bit.
+     * @param n Number of bits to read, at most 64.
+     * @return Read bits, the first one being the most significant.
+     */
+    uint64_t readBits(std::size_t pos, std::size_t n) const noexcept;
+
+    /**
+     * View of underlying 32-bit blocks.
+     *
+     * Bits are stored starting from the most significant bit of the first block.
+     *
+     * @return Block view.
+     */
+    BlockView blocks() const noexcept;
+
     /**
      * Pushes unsigned 32-bit integer in the beginning of the array.
      *
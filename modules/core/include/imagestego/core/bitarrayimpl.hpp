@@ -52,6 +52,20 @@ public:
     typedef BitIterator iterator;
     typedef const BitIterator const_iterator;
 
+    /**
+     * Read-only view of underlying blocks.
+     *
+     * Bits are stored in 32-bit blocks starting from the most significant bit, bits
+     * past size() in the last block are zero.
+     */
+    struct BlockView {
+        /** Pointer to the first block. */
+        const uint32_t* data;
+
+        /** Number of blocks. */
+        std::size_t size;
+    };
+
     bool operator==(const BitArray& other);
 
     /**
@@ -154,6 +168,40 @@ public:
      */
     void put(std::size_t num, std::size_t n);
 
+    /**
+     * Appends n lowest bits of number, most significant first.
+     *
+     * @param bits Number from which bits are taken.
+     * @param n Number of bits to append, at most 64.
+     */
+    void appendBits(uint64_t bits, std::size_t n);
+
+    /**
+     * Appends bytes to the array.
+     *
+     * @param data Pointer to bytes.
+     * @param len Number of bytes.
+     */
+    void appendBytes(const uint8_t* data, std::size_t len);
+
+    /**
+     * Reads n bits starting from given position.
+     *
+     * Bits past the end of array are read as zeros.
+     *
+     * @param pos Position of the first bit.
+     * @param n Number of bits to read, at most 64.
+     * @return Read bits, the first one being the most significant.
+     */
+    uint64_t readBits(std::size_t pos, std::size_t n) const noexcept;
+
+    /**
+     * View of underlying blocks.
+     *
+     * @return Block view.
+     */
+    BlockView blocks() const noexcept;
+
     /**
      * Pushes unsigned 32-bit integer in the beginning of the array.
      *
@@ -361,6 +409,16 @@ private:
     inline static IMAGESTEGO_CONSTEXPR std::size_t bitIndex(std::size_t i) {
         return i % bitsPerBlock;
     }
+
+    /**
+     * Block by index or zero if index is out of range.
+     *
+     * @param i Index of block.
+     * @return Block value.
+     */
+    inline BlockType blockAt(std::size_t i) const noexcept {
+        return i < _blocks.size() ? _blocks[i] : 0;
+    }
 }; // class BitArray
 
 } // namespace impl
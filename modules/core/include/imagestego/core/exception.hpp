@@ -46,7 +46,15 @@ public:
         NoKeyFound = 1 << 2,
         InternalError = 1 << 3,
         UnknownLsbMode = 1 << 4,
-        NotJpegClass = 1 << 5
+        NotJpegClass = 1 << 5,
+        InvalidWaveletLevel = 1 << 6,
+        InvalidStrip = 1 << 7,
+        IncompleteImage = 1 << 8,
+        UnsupportedCodec = 1 << 9,
+        CorruptedMessage = 1 << 10,
+        InvalidImageType = 1 << 11,
+        NotImplemented = 1 << 12,
+        CorruptedImage = 1 << 13
     };
 
 private:
@@ -72,6 +80,22 @@ inline const char* imagestego::Exception::what() const noexcept {
             return "Class 'LsbEmbedder' doesn't support JPEG pictures. Use "
                    "'JpegLsbEmbedder' "
                    "instead";
+        case Codes::InvalidWaveletLevel:
+            return "Invalid wavelet decomposition level";
+        case Codes::InvalidStrip:
+            return "Strip doesn't match image size";
+        case Codes::IncompleteImage:
+            return "Not all image strips were processed";
+        case Codes::UnsupportedCodec:
+            return "Codec is not available";
+        case Codes::CorruptedMessage:
+            return "Encoded message is corrupted";
+        case Codes::InvalidImageType:
+            return "Image must have type CV_8UC3";
+        case Codes::NotImplemented:
+            return "Operation is not supported by this algorithm";
+        case Codes::CorruptedImage:
+            return "Image is corrupted";
         default:
             return "Unknown Error";
     }
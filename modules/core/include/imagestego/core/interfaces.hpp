@@ -29,7 +29,9 @@
 #include "imagestego/core/bitarray.hpp"
 #include "imagestego/core/config.hpp"
 // c++
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace imagestego {
 
@@ -42,6 +44,12 @@ public:
      * @brief Source image setter.
      */
     virtual void setImage(const std::string& imageName) = 0;
+    /**
+     * @brief Source image setter from encoded image buffer.
+     *
+     * @throws imagestego::Exception if not overridden.
+     */
+    virtual void setImage(const std::vector<uint8_t>& buf);
     /**
      * @brief Secret message setter.
      */
@@ -54,6 +62,12 @@ public:
      * @brief Method for creating stego container.
      */
     virtual void createStegoContainer(const std::string& dst) = 0;
+    /**
+     * @brief Method for creating stego container encoded into buffer.
+     *
+     * @throws imagestego::Exception if not overridden.
+     */
+    virtual void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext);
     virtual ~StegoEmbedder() = default;
 }; // class StegoEmbedder
 
@@ -66,6 +80,12 @@ public:
      * @brief Source image setter.
      */
     virtual void setImage(const std::string& imageName) = 0;
+    /**
+     * @brief Source image setter from encoded image buffer.
+     *
+     * @throws imagestego::Exception if not overridden.
+     */
+    virtual void setImage(const std::vector<uint8_t>& buf);
     /**
      * @brief Setter for secret key.
      */
@@ -109,6 +129,49 @@ public:
     virtual ~Decoder() noexcept = default;
 }; // class Decoder
 
+/**
+ * @brief Interface for encoders processing message chunk by chunk.
+ *
+ * Concatenation of all read() results is the same as encoding of the whole message.
+ */
+class IMAGESTEGO_EXPORTS StreamEncoder {
+public:
+    /**
+     * @brief Feeds next chunk of message, write() after finish() starts a new one.
+     */
+    virtual void write(const char* data, std::size_t len) = 0;
+    /**
+     * @brief Marks end of message.
+     */
+    virtual void finish() = 0;
+    /**
+     * @brief Takes bits encoded since the previous call.
+     */
+    virtual BitArray read() = 0;
+    virtual ~StreamEncoder() noexcept = default;
+}; // class StreamEncoder
+
+/**
+ * @brief Interface for decoders processing encoded message chunk by chunk.
+ */
+class IMAGESTEGO_EXPORTS StreamDecoder {
+public:
+    /**
+     * @brief Feeds next chunk of encoded message, write() after finish() starts a new
+     * one.
+     */
+    virtual void write(const BitArray& arr) = 0;
+    /**
+     * @brief Marks end of encoded message.
+     */
+    virtual void finish() = 0;
+    /**
+     * @brief Takes bytes decoded since the previous call.
+     */
+    virtual std::string read() = 0;
+    virtual ~StreamDecoder() noexcept = default;
+}; // class StreamDecoder
+
 } // namespace imagestego
 
 #endif /* __IMAGESTEGO_CORE_INTERFACES_HPP_INCLUDED__ */
@@ -0,0 +1,158 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_CORE_PERMUTATION_HPP_INCLUDED__
+#define __IMAGESTEGO_CORE_PERMUTATION_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core/config.hpp"
+// c++ headers
+#include <random>
+
+namespace imagestego {
+
+/**
+ * @brief Keyed pseudo-random permutation of integer range.
+ *
+ * Permutation of [0, n) is defined by balanced Feistel network with cycle walking, so
+ * k-th element is computed in O(1) and permutation itself is never stored.
+ */
+class IMAGESTEGO_EXPORTS Permutation {
+public:
+    /**
+     * Constructs empty permutation.
+     */
+    explicit Permutation() noexcept;
+
+    /**
+     * Constructs permutation of [0, n).
+     *
+     * @param n Size of permuted range.
+     * @param gen PRNG used to draw round keys.
+     */
+    explicit Permutation(uint64_t n, std::mt19937& gen);
+
+    /**
+     * Constructs permutation of [0, n).
+     *
+     * @param n Size of permuted range.
+     * @param seed Seed for round keys.
+     */
+    explicit Permutation(uint64_t n, uint32_t seed);
+
+    /**
+     * Computes k-th element of permutation.
+     *
+     * @param k Index of element, must be less than size().
+     * @return k-th element.
+     */
+    inline uint64_t operator[](uint64_t k) const noexcept {
+        // cycle walking: encrypt() permutes [0, 4^_halfBits), which covers [0, _n)
+        do {
+            k = encrypt(k);
+        } while (k >= _n);
+        return k;
+    }
+
+    /**
+     * Computes position of element in permutation, i.e. inverse permutation.
+     *
+     * @param x Element, must be less than size().
+     * @return k such that (*this)[k] == x.
+     */
+    inline uint64_t index(uint64_t x) const noexcept {
+        // walks the cycle backwards, so it stops at the same index operator[] started
+        do {
+            x = decrypt(x);
+        } while (x >= _n);
+        return x;
+    }
+
+    /**
+     * Size of permuted range.
+     *
+     * @return Number of elements.
+     */
+    inline uint64_t size() const noexcept { return _n; }
+
+private:
+    /** Number of Feistel rounds. */
+    static const int rounds = 4;
+
+    /** Size of permuted range. */
+    uint64_t _n = 0;
+
+    /** Number of bits in each half of the block. */
+    unsigned int _halfBits = 1;
+
+    /** Mask for one half of the block. */
+    uint64_t _mask = 1;
+
+    /** Round keys. */
+    uint64_t _keys[rounds] = {0};
+
+    /**
+     * Initializes block size for given range.
+     */
+    void init(uint64_t n) noexcept;
+
+    /**
+     * Round function (splitmix64 finalizer).
+     */
+    static inline uint64_t mix(uint64_t x) noexcept {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * Applies Feistel network to the block.
+     */
+    inline uint64_t encrypt(uint64_t x) const noexcept {
+        uint64_t left = x >> _halfBits, right = x & _mask;
+        for (int i = 0; i != rounds; ++i) {
+            const uint64_t tmp = left ^ (mix(right ^ _keys[i]) & _mask);
+            left = right;
+            right = tmp;
+        }
+        return (left << _halfBits) | right;
+    }
+
+    /**
+     * Inverse of encrypt(), applies rounds in reverse order.
+     */
+    inline uint64_t decrypt(uint64_t x) const noexcept {
+        uint64_t left = x >> _halfBits, right = x & _mask;
+        for (int i = rounds - 1; i >= 0; --i) {
+            const uint64_t tmp = right ^ (mix(left ^ _keys[i]) & _mask);
+            right = left;
+            left = tmp;
+        }
+        return (left << _halfBits) | right;
+    }
+}; // class Permutation
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_CORE_PERMUTATION_HPP_INCLUDED__ */
@@ -0,0 +1,124 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_CORE_THREAD_POOL_HPP_INCLUDED__
+#define __IMAGESTEGO_CORE_THREAD_POOL_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core/config.hpp"
+// c++ headers
+#include <cstddef>
+#include <functional>
+
+namespace imagestego {
+
+namespace impl {
+
+class ThreadPool;
+
+} // namespace impl
+
+/**
+ * @brief Persistent work-stealing thread pool.
+ *
+ * Every worker owns a task deque. Tasks submitted from a worker go to its own deque,
+ * other tasks are distributed round-robin. Idle workers steal from other deques.
+ */
+class IMAGESTEGO_EXPORTS ThreadPool {
+public:
+    /**
+     * Constructs pool and starts workers.
+     *
+     * @param threads Number of workers, 0 means number of hardware threads.
+     */
+    explicit ThreadPool(std::size_t threads = 0);
+
+    /**
+     * Finishes queued tasks and joins workers.
+     */
+    virtual ~ThreadPool() noexcept;
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queues task for execution.
+     *
+     * @param task Task to be executed.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Waits until all submitted tasks are finished.
+     *
+     * Rethrows the first exception thrown by a task, if any.
+     */
+    void wait();
+
+    /**
+     * Number of workers.
+     *
+     * @return Number of workers.
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * Index of current worker.
+     *
+     * @return Index in [0, size()) if called from a worker of this pool, -1 otherwise.
+     */
+    int workerIndex() const noexcept;
+
+private:
+    /** Pointer to implementation. */
+    impl::ThreadPool* _pool;
+}; // class ThreadPool
+
+/**
+ * @brief Returns pool shared by parallel algorithms of the library.
+ *
+ * Pool is created on first use and has one worker per hardware thread.
+ *
+ * @return Shared pool.
+ */
+IMAGESTEGO_EXPORTS ThreadPool& sharedThreadPool();
+
+/**
+ * @brief Calls body(i) for every i in [0, count) in parallel.
+ *
+ * Calling thread takes part in the work, so it is safe to call it from a worker of the
+ * same pool. Unlike ThreadPool::wait(), only iterations of this call are waited for.
+ *
+ * @param count Number of iterations.
+ * @param body Function to be called.
+ * @param pool Pool which runs iterations.
+ * @throws Rethrows the first exception thrown by body.
+ */
+IMAGESTEGO_EXPORTS void parallelFor(std::size_t count,
+                                    const std::function<void(std::size_t)>& body,
+                                    ThreadPool& pool = sharedThreadPool());
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_CORE_THREAD_POOL_HPP_INCLUDED__ */
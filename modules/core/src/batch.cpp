@@ -0,0 +1,236 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/core/batch.hpp"
+#include "imagestego/core/thread_pool.hpp"
+// c++ headers
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace imagestego {
+
+namespace impl {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+bool readFile(const std::string& path, std::vector<uint8_t>& buf) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+    buf.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& buf) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        return false;
+    out.write(reinterpret_cast<const char*>(buf.data()),
+              static_cast<std::streamsize>(buf.size()));
+    return out.good();
+}
+
+std::string extension(const std::string& path) {
+    const auto dot = path.find_last_of('.');
+    const auto slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return ".png";
+    return path.substr(dot);
+}
+
+double elapsed(const Clock::time_point& start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+class BatchEmbedder final {
+public:
+    explicit BatchEmbedder(imagestego::BatchEmbedder::Factory factory, std::size_t threads,
+                           std::size_t maxInFlight)
+        : _factory(std::move(factory)), _pool(threads),
+          _maxInFlight(maxInFlight ? maxInFlight : 2 * _pool.size()),
+          _embedders(_pool.size()) {}
+    BatchReport run(const std::vector<BatchJob>& jobs) {
+        BatchReport report;
+        report.results.resize(jobs.size());
+        std::vector<Clock::time_point> started(jobs.size());
+        const auto start = Clock::now();
+        _done = false;
+        _inFlight = 0;
+        {
+            std::thread writer(&BatchEmbedder::write, this, std::cref(jobs),
+                               std::ref(report.results), std::cref(started));
+            // tasks and the writer refer to locals, so they are finished on every path
+            Finisher finisher = {*this, writer};
+            submit(jobs, report, started);
+        }
+        for (const auto& res : report.results) {
+            if (res.status == BatchJobResult::Status::Ok)
+                ++report.succeeded;
+            else
+                ++report.failed;
+        }
+        report.seconds = elapsed(start);
+        return report;
+    }
+
+private:
+    imagestego::BatchEmbedder::Factory _factory;
+    imagestego::ThreadPool _pool;
+    std::size_t _maxInFlight;
+    /** Embedder of every worker, created on first use. */
+    std::vector<std::unique_ptr<StegoEmbedder>> _embedders;
+    std::mutex _mutex;
+    std::condition_variable _released, _written;
+    /** Encoded containers waiting for the writer. */
+    std::deque<std::pair<std::size_t, std::vector<uint8_t>>> _output;
+    std::size_t _inFlight = 0;
+    bool _done = false;
+
+    /** Calls finish() when run() is left, including by exception. */
+    struct Finisher {
+        BatchEmbedder& batch;
+        std::thread& writer;
+        ~Finisher() noexcept { batch.finish(writer); }
+    }; // struct Finisher
+
+    /** Reads images and queues embedding tasks. */
+    void submit(const std::vector<BatchJob>& jobs, BatchReport& report,
+                std::vector<Clock::time_point>& started) {
+        for (std::size_t i = 0; i != jobs.size(); ++i) {
+            {
+                // bound memory: wait until the writer releases an image
+                std::unique_lock<std::mutex> lock(_mutex);
+                _released.wait(lock, [this] { return _inFlight < _maxInFlight; });
+                ++_inFlight;
+            }
+            started[i] = Clock::now();
+            std::shared_ptr<std::vector<uint8_t>> buf(new std::vector<uint8_t>);
+            if (!readFile(jobs[i].image, *buf)) {
+                report.results[i].status = BatchJobResult::Status::ReadFailed;
+                report.results[i].error = "Cannot read " + jobs[i].image;
+                report.results[i].seconds = elapsed(started[i]);
+                release();
+                continue;
+            }
+            _pool.submit([this, &jobs, &report, buf, i]() {
+                embed(jobs[i], buf, report.results[i], i);
+            });
+        }
+    }
+    /** Waits for queued tasks and stops the writer. */
+    void finish(std::thread& writer) noexcept {
+        try {
+            _pool.wait();
+        } catch (...) {
+            // embed() reports its own errors, nothing else is expected here
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _written.notify_one();
+        writer.join();
+    }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_inFlight;
+        }
+        _released.notify_one();
+    }
+    void embed(const BatchJob& job, const std::shared_ptr<std::vector<uint8_t>>& buf,
+               BatchJobResult& result, std::size_t idx) {
+        std::vector<uint8_t> container;
+        try {
+            auto& embedder = _embedders[_pool.workerIndex()];
+            if (!embedder)
+                embedder.reset(_factory());
+            embedder->setImage(*buf);
+            embedder->setMessage(job.message);
+            embedder->setSecretKey(job.key);
+            embedder->createStegoContainer(container, extension(job.output));
+        } catch (const std::exception& e) {
+            result.status = BatchJobResult::Status::EmbedFailed;
+            result.error = e.what();
+        } catch (...) {
+            result.status = BatchJobResult::Status::EmbedFailed;
+            result.error = "Unknown error";
+        }
+        buf->clear();
+        buf->shrink_to_fit();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _output.emplace_back(idx, std::move(container));
+        }
+        _written.notify_one();
+    }
+    void write(const std::vector<BatchJob>& jobs, std::vector<BatchJobResult>& results,
+               const std::vector<Clock::time_point>& started) {
+        while (true) {
+            std::pair<std::size_t, std::vector<uint8_t>> item;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _written.wait(lock, [this] { return _done || !_output.empty(); });
+                if (_output.empty())
+                    return;
+                item = std::move(_output.front());
+                _output.pop_front();
+            }
+            auto& result = results[item.first];
+            if (result.status == BatchJobResult::Status::Ok &&
+                !writeFile(jobs[item.first].output, item.second)) {
+                result.status = BatchJobResult::Status::WriteFailed;
+                result.error = "Cannot write " + jobs[item.first].output;
+            }
+            result.seconds = elapsed(started[item.first]);
+            release();
+        }
+    }
+}; // class BatchEmbedder
+
+} // namespace impl
+
+BatchEmbedder::BatchEmbedder(Factory factory, std::size_t threads,
+                             std::size_t maxInFlight)
+    : _pImpl(new impl::BatchEmbedder(std::move(factory), threads, maxInFlight)) {}
+
+BatchEmbedder::~BatchEmbedder() noexcept { delete _pImpl; }
+
+BatchReport BatchEmbedder::run(const std::vector<BatchJob>& jobs) { return _pImpl->run(jobs); }
+
+} // namespace imagestego
@@ -100,6 +100,18 @@ std::size_t BitArray::toInt() const { return _arr->toInt(); }
 
 void BitArray::put(std::size_t num, std::size_t n) { _arr->put(num, n); }
 
+void BitArray::appendBits(uint64_t bits, std::size_t n) { _arr->appendBits(bits, n); }
+
+void BitArray::appendBytes(const uint8_t* data, std::size_t len) {
+    _arr->appendBytes(data, len);
+}
+
+uint64_t BitArray::readBits(std::size_t pos, std::size_t n) const noexcept {
+    return _arr->readBits(pos, n);
+}
+
+typename BitArray::BlockView BitArray::blocks() const noexcept { return _arr->blocks(); }
+
 bool BitArray::operator==(const BitArray& other) { return *_arr == *other._arr; }
 
 } // namespace imagestego
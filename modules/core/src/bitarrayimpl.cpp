@@ -131,14 +131,8 @@ bool BitArray::operator[](std::size_t i) const {
 std::size_t BitArray::size() const noexcept { return _sz; }
 
 BitArray BitArray::fromByteString(std::string str) {
-    BitArray arr(str.size() * CHAR_BIT);
-    if (str.size() % sizeof(BlockType) != 0)
-        str.append(sizeof(BlockType) - str.size() % sizeof(BlockType), '\0');
-    memcpy(&arr._blocks[0], str.data(), str.size() * sizeof(char));
-#ifdef IMAGESTEGO_LITTLE_ENDIAN
-    std::for_each(arr._blocks.begin(), arr._blocks.end(),
-                  [](uint32_t& value) { value = bswap(value); });
-#endif
+    BitArray arr;
+    arr.appendBytes(reinterpret_cast<const uint8_t*>(str.data()), str.size());
     return arr;
 }
 
@@ -156,13 +150,70 @@ void BitArray::pushBack(bool val) {
     ++_sz;
 }
 
-void BitArray::put(std::size_t num, std::size_t n) {
-    for (; n != 0; --n) {
-        const std::size_t offset = n - 1;
-        pushBack((num & (1 << offset)) != 0);
+void BitArray::put(std::size_t num, std::size_t n) { appendBits(num, n); }
+
+void BitArray::appendBits(uint64_t bits, std::size_t n) {
+    if (n == 0)
+        return;
+    if (n < 64)
+        bits &= (uint64_t(1) << n) - 1;
+    _blocks.resize(numberOfBlocks(_sz + n), 0);
+    while (n != 0) {
+        const std::size_t offset = bitIndex(_sz);
+        const std::size_t take = std::min(bitsPerBlock - offset, n);
+        const uint64_t chunk = (bits >> (n - take)) & ((uint64_t(1) << take) - 1);
+        _blocks[blockIndex(_sz)] |=
+            static_cast<BlockType>(chunk << (bitsPerBlock - offset - take));
+        _sz += take;
+        n -= take;
     }
 }
 
+void BitArray::appendBytes(const uint8_t* data, std::size_t len) {
+    if (len == 0)
+        return;
+    if (bitIndex(_sz) == 0) {
+        // block-aligned: copy whole bytes at once and fix byte order
+        const std::size_t first = blockIndex(_sz);
+        _blocks.resize(numberOfBlocks(_sz + len * CHAR_BIT), 0);
+        memcpy(&_blocks[first], data, len);
+#ifdef IMAGESTEGO_LITTLE_ENDIAN
+        std::for_each(_blocks.begin() + first, _blocks.end(),
+                      [](uint32_t& value) { value = bswap(value); });
+#endif
+        _sz += len * CHAR_BIT;
+        return;
+    }
+    std::size_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        for (std::size_t j = 0; j != sizeof(uint64_t); ++j)
+            word = (word << CHAR_BIT) | data[i + j];
+        appendBits(word, 64);
+    }
+    for (; i != len; ++i)
+        appendBits(data[i], CHAR_BIT);
+}
+
+uint64_t BitArray::readBits(std::size_t pos, std::size_t n) const noexcept {
+    if (n == 0)
+        return 0;
+    const std::size_t block = blockIndex(pos), offset = bitIndex(pos);
+    const uint64_t window = (static_cast<uint64_t>(blockAt(block)) << bitsPerBlock) |
+                            blockAt(block + 1);
+    uint64_t res = (window << offset) >> (64 - n);
+    if (offset + n > 64)
+        res |= blockAt(block + 2) >> (3 * bitsPerBlock - offset - n);
+    return res;
+}
+
+typename BitArray::BlockView BitArray::blocks() const noexcept {
+    BlockView view;
+    view.data = _blocks.data();
+    view.size = _blocks.size();
+    return view;
+}
+
 void BitArray::pushFront(std::size_t num) {
     _blocks.insert(_blocks.begin(), num);
     _sz += 32;
@@ -180,14 +231,20 @@ typename BitArray::iterator BitArray::begin() { return BitIterator(this, 0); }
 typename BitArray::iterator BitArray::end() { return BitIterator(this, _sz); }
 
 std::string BitArray::toByteString() const {
-    std::string str(_sz / CHAR_BIT, '\0');
-#if IMAGESTEGO_LITTLE_ENDIAN
-    auto tmp = _blocks;
-    std::for_each(tmp.begin(), tmp.end(), [](uint32_t& value) { value = bswap(value); });
-    memcpy(&str[0], &tmp[0], tmp.size() * sizeof(BlockType));
+    const std::size_t len = _sz / CHAR_BIT, full = len / sizeof(BlockType);
+    std::string str(len, '\0');
+    for (std::size_t i = 0; i != full; ++i) {
+#ifdef IMAGESTEGO_LITTLE_ENDIAN
+        const BlockType value = bswap(_blocks[i]);
 #else
-    memcpy(&str[0], &_blocks[0], _blocks.size() * sizeof(BlockType));
+        const BlockType value = _blocks[i];
 #endif
+        memcpy(&str[i * sizeof(BlockType)], &value, sizeof(BlockType));
+    }
+    for (std::size_t i = full * sizeof(BlockType); i != len; ++i)
+        str[i] = static_cast<char>(
+            _blocks[i / sizeof(BlockType)] >>
+            (bitsPerBlock - CHAR_BIT * (i % sizeof(BlockType) + 1)));
     return str;
 }
 
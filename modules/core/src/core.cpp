@@ -35,4 +35,19 @@ uint32_t hash(const std::string& _key) {
     return tmp[0];
 }
 
+// in-memory methods were added after the interfaces had been published, so
+// implementations which don't know about them keep compiling
+
+void StegoEmbedder::setImage(const std::vector<uint8_t>&) {
+    throw Exception(Exception::Codes::NotImplemented);
+}
+
+void StegoEmbedder::createStegoContainer(std::vector<uint8_t>&, const std::string&) {
+    throw Exception(Exception::Codes::NotImplemented);
+}
+
+void StegoExtracter::setImage(const std::vector<uint8_t>&) {
+    throw Exception(Exception::Codes::NotImplemented);
+}
+
 } // namespace imagestego
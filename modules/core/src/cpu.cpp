@@ -0,0 +1,130 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/core/cpu.hpp"
+// c++ headers
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define IMAGESTEGO_CPU_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define IMAGESTEGO_CPU_AARCH64 1
+#elif defined(__arm__) && defined(__linux__)
+#define IMAGESTEGO_CPU_ARM_LINUX 1
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace imagestego {
+
+namespace {
+
+struct CpuFeatures {
+    bool sse2 = false, ssse3 = false, avx2 = false, avx512bw = false, avx512vl = false,
+         neon = false;
+
+    CpuFeatures() noexcept {
+#if IMAGESTEGO_CPU_X86
+        uint32_t regs[4];
+        cpuid(0, regs);
+        const uint32_t maxLeaf = regs[0];
+        if (maxLeaf < 1)
+            return;
+        cpuid(1, regs);
+        sse2 = (regs[3] & (1u << 26)) != 0;
+        ssse3 = (regs[2] & (1u << 9)) != 0;
+        // AVX state must be enabled by OS: OSXSAVE and XCR0 bits
+        const bool osxsave = (regs[2] & (1u << 27)) != 0;
+        const uint64_t xcr0 = osxsave ? xgetbv() : 0;
+        const bool ymm = (xcr0 & 0x6) == 0x6, zmm = (xcr0 & 0xe6) == 0xe6;
+        if (maxLeaf < 7)
+            return;
+        cpuid(7, regs);
+        avx2 = ymm && (regs[1] & (1u << 5)) != 0;
+        const bool avx512f = zmm && (regs[1] & (1u << 16)) != 0;
+        avx512bw = avx512f && (regs[1] & (1u << 30)) != 0;
+        avx512vl = avx512f && (regs[1] & (1u << 31)) != 0;
+#elif IMAGESTEGO_CPU_AARCH64
+        neon = true;
+#elif IMAGESTEGO_CPU_ARM_LINUX
+        neon = (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#endif
+    }
+
+#if IMAGESTEGO_CPU_X86
+    static void cpuid(uint32_t leaf, uint32_t* regs) noexcept {
+#ifdef _MSC_VER
+        int tmp[4];
+        __cpuidex(tmp, static_cast<int>(leaf), 0);
+        for (int i = 0; i != 4; ++i)
+            regs[i] = static_cast<uint32_t>(tmp[i]);
+#else
+        __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+    static uint64_t xgetbv() noexcept {
+#ifdef _MSC_VER
+        return _xgetbv(0);
+#else
+        uint32_t eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+    }
+#endif
+}; // struct CpuFeatures
+
+const CpuFeatures& features() noexcept {
+    static const CpuFeatures instance;
+    return instance;
+}
+
+} // namespace
+
+bool cpuSupports(CpuFeature feature) noexcept {
+    const CpuFeatures& f = features();
+    switch (feature) {
+        case CpuFeature::SSE2:
+            return f.sse2;
+        case CpuFeature::SSSE3:
+            return f.ssse3;
+        case CpuFeature::AVX2:
+            return f.avx2;
+        case CpuFeature::AVX512BW:
+            return f.avx512bw;
+        case CpuFeature::AVX512VL:
+            return f.avx512vl;
+        case CpuFeature::NEON:
+            return f.neon;
+    }
+    return false;
+}
+
+} // namespace imagestego
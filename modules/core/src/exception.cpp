@@ -45,6 +45,22 @@ const char* Exception::what() const noexcept {
             return "Class 'LsbEmbedder' doesn't support JPEG pictures. Use "
                    "'JpegLsbEmbedder' "
                    "instead";
+        case Codes::InvalidWaveletLevel:
+            return "Invalid wavelet decomposition level";
+        case Codes::InvalidStrip:
+            return "Strip doesn't match image size";
+        case Codes::IncompleteImage:
+            return "Not all image strips were processed";
+        case Codes::UnsupportedCodec:
+            return "Codec is not available";
+        case Codes::CorruptedMessage:
+            return "Encoded message is corrupted";
+        case Codes::InvalidImageType:
+            return "Image must have type CV_8UC3";
+        case Codes::NotImplemented:
+            return "Operation is not supported by this algorithm";
+        case Codes::CorruptedImage:
+            return "Image is corrupted";
         default:
             return "Unknown Error";
     }
@@ -0,0 +1,64 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/core/permutation.hpp"
+// c++ headers
+#include <random>
+
+namespace imagestego {
+
+Permutation::Permutation() noexcept {}
+
+Permutation::Permutation(uint64_t n, std::mt19937& gen) {
+    init(n);
+    for (int i = 0; i != rounds; ++i) {
+        // separate statements: operand evaluation order is unspecified
+        const uint64_t hi = gen();
+        const uint64_t lo = gen();
+        _keys[i] = (hi << 32) | lo;
+    }
+}
+
+Permutation::Permutation(uint64_t n, uint32_t seed) {
+    init(n);
+    std::mt19937 gen(seed);
+    for (int i = 0; i != rounds; ++i) {
+        // separate statements: operand evaluation order is unspecified
+        const uint64_t hi = gen();
+        const uint64_t lo = gen();
+        _keys[i] = (hi << 32) | lo;
+    }
+}
+
+void Permutation::init(uint64_t n) noexcept {
+    _n = n;
+    _halfBits = 1;
+    // smallest even-width block covering [0, n)
+    while (_halfBits < 32 && (uint64_t(1) << (2 * _halfBits)) < n)
+        ++_halfBits;
+    _mask = (uint64_t(1) << _halfBits) - 1;
+}
+
+} // namespace imagestego
@@ -0,0 +1,252 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/core/thread_pool.hpp"
+// c++ headers
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace imagestego {
+
+namespace impl {
+
+class ThreadPool final {
+public:
+    explicit ThreadPool(std::size_t threads) {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t i = 0; i != threads; ++i)
+            _queues.emplace_back(new Queue);
+        _workers.reserve(threads);
+        for (std::size_t i = 0; i != threads; ++i)
+            _workers.emplace_back(&ThreadPool::run, this, i);
+    }
+    ~ThreadPool() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_all();
+        for (auto& worker : _workers)
+            worker.join();
+    }
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_queued;
+            ++_unfinished;
+        }
+        const int current = workerIndex();
+        const std::size_t idx =
+            (current >= 0) ? static_cast<std::size_t>(current) : _next++ % _queues.size();
+        {
+            std::lock_guard<std::mutex> lock(_queues[idx]->mutex);
+            _queues[idx]->tasks.push_back(std::move(task));
+        }
+        _cv.notify_one();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _unfinished == 0; });
+        if (_error) {
+            std::exception_ptr error = _error;
+            _error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+    inline std::size_t size() const noexcept { return _workers.size(); }
+    inline int workerIndex() const noexcept {
+        return (currentPool == this) ? currentIndex : -1;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    static thread_local const ThreadPool* currentPool;
+    static thread_local int currentIndex;
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _cv, _done;
+    /** Number of tasks waiting in queues. */
+    std::size_t _queued = 0;
+    /** Number of submitted but not finished tasks. */
+    std::size_t _unfinished = 0;
+    std::atomic<std::size_t> _next{0};
+    std::exception_ptr _error;
+    bool _stop = false;
+
+    /**
+     * Takes task from own deque (newest first) or steals from others (oldest first).
+     */
+    bool pop(std::size_t idx, std::function<void()>& task) {
+        {
+            std::lock_guard<std::mutex> lock(_queues[idx]->mutex);
+            auto& tasks = _queues[idx]->tasks;
+            if (!tasks.empty()) {
+                task = std::move(tasks.back());
+                tasks.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t i = 1; i != _queues.size(); ++i) {
+            auto& queue = *_queues[(idx + i) % _queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+    void run(std::size_t idx) {
+        currentPool = this;
+        currentIndex = static_cast<int>(idx);
+        std::function<void()> task;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [this] { return _stop || _queued != 0; });
+                if (_queued == 0)
+                    return;
+            }
+            // task may be counted but not pushed yet, or taken by another worker
+            if (!pop(idx, task)) {
+                std::this_thread::yield();
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_queued;
+            }
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            task = nullptr;
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (error && !_error)
+                _error = error;
+            if (--_unfinished == 0)
+                _done.notify_all();
+        }
+    }
+}; // class ThreadPool
+
+thread_local const ThreadPool* ThreadPool::currentPool = nullptr;
+thread_local int ThreadPool::currentIndex = -1;
+
+struct ParallelFor {
+    explicit ParallelFor(std::size_t count) : count(count), remaining(count) {}
+
+    const std::size_t count;
+    std::atomic<std::size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    /** Number of iterations not finished yet. */
+    std::size_t remaining;
+    std::exception_ptr error;
+
+    /**
+     * Takes iterations until none is left. Late helpers find nothing to do and never
+     * touch body.
+     */
+    void run(const std::function<void(std::size_t)>& body) {
+        std::size_t finished = 0;
+        std::exception_ptr err;
+        for (std::size_t i = next++; i < count; i = next++) {
+            if (!err) {
+                try {
+                    body(i);
+                } catch (...) {
+                    err = std::current_exception();
+                }
+            }
+            ++finished;
+        }
+        if (finished == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (err && !error)
+            error = err;
+        remaining -= finished;
+        if (remaining == 0)
+            done.notify_all();
+    }
+}; // struct ParallelFor
+
+} // namespace impl
+
+ThreadPool::ThreadPool(std::size_t threads) : _pool(new impl::ThreadPool(threads)) {}
+
+ThreadPool::~ThreadPool() noexcept { delete _pool; }
+
+void ThreadPool::submit(std::function<void()> task) { _pool->submit(std::move(task)); }
+
+void ThreadPool::wait() { _pool->wait(); }
+
+std::size_t ThreadPool::size() const noexcept { return _pool->size(); }
+
+int ThreadPool::workerIndex() const noexcept { return _pool->workerIndex(); }
+
+ThreadPool& sharedThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body,
+                 ThreadPool& pool) {
+    if (count == 0)
+        return;
+    if (count == 1) {
+        body(0);
+        return;
+    }
+    std::shared_ptr<impl::ParallelFor> state(new impl::ParallelFor(count));
+    const std::size_t helpers = std::min(count - 1, pool.size());
+    for (std::size_t i = 0; i != helpers; ++i)
+        pool.submit([state, &body] { state->run(body); });
+    state->run(body);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state] { return state->remaining == 0; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+} // namespace imagestego
@@ -0,0 +1,112 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego
+#include "imagestego/core/batch.hpp"
+#include "imagestego/core/exception.hpp"
+// gtest
+#include <gtest/gtest.h>
+// c++ headers
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<int> created(0);
+
+/**
+ * Embedder appending message and key to the image bytes.
+ */
+class DummyEmbedder : public imagestego::StegoEmbedder {
+public:
+    DummyEmbedder() noexcept { ++created; }
+    void setImage(const std::string&) override {}
+    void setImage(const std::vector<uint8_t>& buf) override { _image = buf; }
+    void setMessage(const std::string& msg) override { _msg = msg; }
+    void setSecretKey(const std::string& key) override { _key = key; }
+    void createStegoContainer(const std::string&) override {}
+    void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) override {
+        if (_msg.size() > _image.size())
+            throw imagestego::Exception(imagestego::Exception::Codes::BigMessageSize);
+        dst = _image;
+        dst.insert(dst.end(), _msg.begin(), _msg.end());
+        dst.insert(dst.end(), _key.begin(), _key.end());
+        dst.insert(dst.end(), ext.begin(), ext.end());
+    }
+
+private:
+    std::vector<uint8_t> _image;
+    std::string _msg, _key;
+}; // class DummyEmbedder
+
+std::string readAll(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST(Batch, BatchEmbedder) {
+    const std::string dir = ::testing::TempDir();
+    const std::string input = dir + "batch_input.bin";
+    std::ofstream(input, std::ios::binary) << "image data";
+    std::vector<imagestego::BatchJob> jobs;
+    for (int i = 0; i != 20; ++i) {
+        imagestego::BatchJob job;
+        job.image = input;
+        job.message = "msg" + std::to_string(i);
+        job.key = "key";
+        job.output = dir + "batch_output" + std::to_string(i) + ".png";
+        jobs.push_back(job);
+    }
+    jobs[3].image = dir + "no_such_file.bin";
+    jobs[7].message = std::string(100, 'x');
+
+    created = 0;
+    imagestego::BatchEmbedder batch([] { return new DummyEmbedder; }, 2, 3);
+    imagestego::BatchReport report = batch.run(jobs);
+    ASSERT_EQ(report.results.size(), jobs.size());
+    EXPECT_EQ(report.succeeded, jobs.size() - 2);
+    EXPECT_EQ(report.failed, 2);
+    EXPECT_GT(report.throughput(), 0);
+    EXPECT_EQ(report.results[3].status, imagestego::BatchJobResult::Status::ReadFailed);
+    EXPECT_EQ(report.results[7].status, imagestego::BatchJobResult::Status::EmbedFailed);
+    for (std::size_t i = 0; i != jobs.size(); ++i) {
+        if (i == 3 || i == 7)
+            continue;
+        EXPECT_EQ(report.results[i].status, imagestego::BatchJobResult::Status::Ok);
+        EXPECT_EQ(readAll(jobs[i].output), "image data" + jobs[i].message + "key.png");
+    }
+    // embedders are reused across jobs and runs
+    batch.run(jobs);
+    EXPECT_LE(created, 2);
+
+    std::remove(input.c_str());
+    for (const auto& job : jobs)
+        std::remove(job.output.c_str());
+}
@@ -161,3 +161,49 @@ TEST(Core, BitArrayToInt) {
     arr.pushFront(32);
     EXPECT_EQ(arr.toInt(), 32);
 }
+
+TEST(Core, BitArrayAppendBits) {
+    BitArray arr;
+    arr.appendBits(0x5, 3);
+    arr.appendBits(0xffffffff00000001ull, 64);
+    arr.appendBits(0x2, 2);
+    EXPECT_EQ(arr.size(), 69);
+    EXPECT_EQ(arr.toString(), "101" + std::string(32, '1') + std::string(31, '0') + "110");
+    EXPECT_EQ(arr.readBits(0, 3), 0x5);
+    EXPECT_EQ(arr.readBits(3, 64), 0xffffffff00000001ull);
+    EXPECT_EQ(arr.readBits(67, 2), 0x2);
+    // bits past the end are read as zeros
+    EXPECT_EQ(arr.readBits(67, 8), 0x80);
+}
+
+TEST(Core, BitArrayReadBits) {
+    const std::string s = "1100101011110000101001011100001111111000000111";
+    BitArray arr(s);
+    for (std::size_t pos = 0; pos != s.size(); ++pos) {
+        for (std::size_t n = 1; pos + n <= s.size(); ++n) {
+            uint64_t expected = std::stoull(s.substr(pos, n), nullptr, 2);
+            EXPECT_EQ(arr.readBits(pos, n), expected);
+        }
+    }
+}
+
+TEST(Core, BitArrayAppendBytes) {
+    const std::string msg = "unaligned bytes";
+    BitArray arr("101");
+    arr.appendBytes(reinterpret_cast<const uint8_t*>(msg.data()), msg.size());
+    EXPECT_EQ(arr.size(), 3 + msg.size() * 8);
+    for (std::size_t i = 0; i != msg.size(); ++i)
+        EXPECT_EQ(arr.readBits(3 + i * 8, 8), static_cast<uint8_t>(msg[i]));
+    BitArray aligned;
+    aligned.appendBytes(reinterpret_cast<const uint8_t*>(msg.data()), msg.size());
+    EXPECT_TRUE(aligned == BitArray::fromByteString(msg));
+    EXPECT_EQ(aligned.toByteString(), msg);
+}
+
+TEST(Core, BitArrayBlocks) {
+    BitArray arr = BitArray::fromByteString("\x01\x02\x03\x04\x05");
+    BitArray::BlockView view = arr.blocks();
+    ASSERT_EQ(view.size, 2);
+    EXPECT_EQ(view.data[0], 0x01020304u);
+    EXPECT_EQ(view.data[1], 0x05000000u);
+}
@@ -0,0 +1,55 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego
+#include "imagestego/core/cpu.hpp"
+// gtest
+#include <gtest/gtest.h>
+
+using imagestego::CpuFeature;
+using imagestego::cpuSupports;
+
+TEST(Cpu, FeaturesAreConsistent) {
+    // every extension implies the older ones
+    if (cpuSupports(CpuFeature::AVX512BW)) {
+        EXPECT_TRUE(cpuSupports(CpuFeature::AVX2));
+    }
+    if (cpuSupports(CpuFeature::AVX2)) {
+        EXPECT_TRUE(cpuSupports(CpuFeature::SSSE3));
+    }
+    if (cpuSupports(CpuFeature::SSSE3)) {
+        EXPECT_TRUE(cpuSupports(CpuFeature::SSE2));
+    }
+#if defined(__x86_64__) || defined(_M_X64)
+    EXPECT_TRUE(cpuSupports(CpuFeature::SSE2));
+    EXPECT_FALSE(cpuSupports(CpuFeature::NEON));
+#endif
+}
+
+TEST(Cpu, DetectionIsStable) {
+    for (const auto feature : {CpuFeature::SSE2, CpuFeature::SSSE3, CpuFeature::AVX2,
+                               CpuFeature::AVX512BW, CpuFeature::AVX512VL, CpuFeature::NEON}) {
+        EXPECT_EQ(cpuSupports(feature), cpuSupports(feature));
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego
+#include "imagestego/core.hpp"
+// gtest
+#include <gtest/gtest.h>
+// c++ headers
+#include <string>
+#include <vector>
+
+namespace {
+
+// implementation written against file-only interfaces
+class FileEmbedder : public imagestego::StegoEmbedder {
+public:
+    void setImage(const std::string&) override {}
+    void setMessage(const std::string&) override {}
+    void setSecretKey(const std::string&) override {}
+    void createStegoContainer(const std::string&) override {}
+}; // class FileEmbedder
+
+class FileExtracter : public imagestego::StegoExtracter {
+public:
+    void setImage(const std::string&) override {}
+    void setSecretKey(const std::string&) override {}
+    std::string extractMessage() override { return std::string(); }
+}; // class FileExtracter
+
+} // namespace
+
+TEST(Interfaces, InMemoryMethodsThrowByDefault) {
+    const std::vector<uint8_t> buf(4, 0);
+    std::vector<uint8_t> dst;
+    FileEmbedder emb;
+    imagestego::StegoEmbedder& iemb = emb;
+    EXPECT_THROW(iemb.setImage(buf), imagestego::Exception);
+    EXPECT_THROW(iemb.createStegoContainer(dst, ".png"), imagestego::Exception);
+    FileExtracter ext;
+    imagestego::StegoExtracter& iext = ext;
+    EXPECT_THROW(iext.setImage(buf), imagestego::Exception);
+}
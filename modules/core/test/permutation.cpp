@@ -0,0 +1,66 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego
+#include "imagestego/core/permutation.hpp"
+// gtest
+#include <gtest/gtest.h>
+// c++ headers
+#include <vector>
+
+TEST(Permutation, Bijection) {
+    for (uint64_t n : {1, 2, 3, 7, 64, 1000, 12345}) {
+        imagestego::Permutation p(n, 42u);
+        std::vector<bool> seen(n, false);
+        for (uint64_t i = 0; i != n; ++i) {
+            const uint64_t v = p[i];
+            ASSERT_LT(v, n);
+            ASSERT_FALSE(seen[v]);
+            seen[v] = true;
+        }
+    }
+}
+
+TEST(Permutation, Deterministic) {
+    std::mt19937 gen1(1337), gen2(1337);
+    imagestego::Permutation p1(100000, gen1), p2(100000, gen2);
+    for (uint64_t i = 0; i != 1000; ++i)
+        EXPECT_EQ(p1[i], p2[i]);
+}
+
+TEST(Permutation, DependsOnKey) {
+    imagestego::Permutation p1(100000, 1u), p2(100000, 2u);
+    int same = 0;
+    for (uint64_t i = 0; i != 1000; ++i)
+        same += p1[i] == p2[i];
+    EXPECT_LT(same, 10);
+}
+
+TEST(Permutation, Index) {
+    for (uint64_t n : {1, 2, 3, 7, 64, 1000, 12345}) {
+        imagestego::Permutation p(n, 42u);
+        for (uint64_t i = 0; i != n; ++i)
+            ASSERT_EQ(i, p.index(p[i]));
+    }
+}
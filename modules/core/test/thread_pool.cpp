@@ -0,0 +1,104 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego
+#include "imagestego/core/thread_pool.hpp"
+// gtest
+#include <gtest/gtest.h>
+// c++ headers
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPool, RunsAllTasks) {
+    imagestego::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    std::atomic<int> counter(0);
+    for (int i = 0; i != 1000; ++i)
+        pool.submit([&counter] { ++counter; });
+    pool.wait();
+    EXPECT_EQ(counter, 1000);
+    // pool is reusable after wait()
+    for (int i = 0; i != 100; ++i)
+        pool.submit([&counter] { ++counter; });
+    pool.wait();
+    EXPECT_EQ(counter, 1100);
+}
+
+TEST(ThreadPool, NestedTasks) {
+    imagestego::ThreadPool pool(3);
+    std::atomic<int> counter(0);
+    for (int i = 0; i != 10; ++i) {
+        pool.submit([&pool, &counter] {
+            for (int j = 0; j != 10; ++j)
+                pool.submit([&counter] { ++counter; });
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(counter, 100);
+}
+
+TEST(ThreadPool, WorkerIndex) {
+    imagestego::ThreadPool pool(2);
+    EXPECT_EQ(pool.workerIndex(), -1);
+    std::vector<int> indices(50, -1);
+    for (std::size_t i = 0; i != indices.size(); ++i)
+        pool.submit([&pool, &indices, i] { indices[i] = pool.workerIndex(); });
+    pool.wait();
+    for (int idx : indices) {
+        EXPECT_GE(idx, 0);
+        EXPECT_LT(idx, 2);
+    }
+}
+
+TEST(ThreadPool, Exception) {
+    imagestego::ThreadPool pool(2);
+    pool.submit([] { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    pool.submit([] {});
+    EXPECT_NO_THROW(pool.wait());
+}
+
+TEST(ThreadPool, ParallelFor) {
+    std::vector<int> values(1000, 0);
+    imagestego::parallelFor(values.size(), [&values](std::size_t i) { values[i] += 1; });
+    for (int value : values)
+        EXPECT_EQ(value, 1);
+    // nested calls from workers of the same pool must not deadlock
+    imagestego::ThreadPool pool(2);
+    std::atomic<int> counter(0);
+    for (int i = 0; i != 4; ++i) {
+        pool.submit([&pool, &counter] {
+            imagestego::parallelFor(100, [&counter](std::size_t) { ++counter; }, pool);
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(counter, 400);
+    EXPECT_THROW(imagestego::parallelFor(10,
+                                         [](std::size_t i) {
+                                             if (i == 5)
+                                                 throw std::runtime_error("iteration failed");
+                                         }),
+                 std::runtime_error);
+}
@@ -0,0 +1,68 @@
+#ifndef __IMAGESTEGO_F5_HPP_INCLUDED__
+#define __IMAGESTEGO_F5_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core.hpp"
+#include "imagestego/utils/jpeg_image.hpp"
+// c++ headers
+#include <random>
+#include <string>
+#include <vector>
+
+namespace imagestego {
+
+template<class EncoderType>
+class F5Embedder;
+
+template<class DecoderType>
+class F5Extracter;
+
+// F5: AC coefficients are visited in keyed order, every k message bits are embedded
+// into 2^k - 1 nonzero coefficients by changing at most one of them
+template<>
+class IMAGESTEGO_EXPORTS F5Embedder<void> : public StegoEmbedder {
+public:
+    explicit F5Embedder() noexcept;
+    explicit F5Embedder(const std::string& input);
+    void setImage(const std::string& imageName) override;
+    void setImage(const std::vector<uint8_t>& buf) override;
+    void setMessage(const std::string& msg) override;
+    void setSecretKey(const std::string& key) override;
+    void createStegoContainer(const std::string& dst) override;
+    // container is always JPEG, ext is ignored
+    void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) override;
+    // k of matrix encoding and number of coefficients changed by the last embedding
+    inline int rate() const noexcept { return k; }
+    inline std::size_t changes() const noexcept { return changed; }
+    // estimated number of message bits which fit into image without matrix encoding
+    static std::size_t capacity(const JpegImage& image);
+
+private:
+    JpegImage image;
+    BitArray msg;
+    std::mt19937 gen;
+    bool hasKey = false;
+    int k = 0;
+    std::size_t changed = 0;
+    void embed();
+}; // class F5Embedder
+
+template<>
+class IMAGESTEGO_EXPORTS F5Extracter<void> : public StegoExtracter {
+public:
+    explicit F5Extracter() noexcept;
+    explicit F5Extracter(const std::string& input);
+    void setImage(const std::string& imageName) override;
+    void setImage(const std::vector<uint8_t>& buf) override;
+    void setSecretKey(const std::string& key) override;
+    std::string extractMessage() override;
+
+private:
+    JpegImage image;
+    std::mt19937 gen;
+    bool hasKey = false;
+}; // class F5Extracter
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_F5_HPP_INCLUDED__ */
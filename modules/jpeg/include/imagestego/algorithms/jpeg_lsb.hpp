@@ -3,217 +3,93 @@
 
 // imagestego headers
 #include "imagestego/core.hpp"
-#include "imagestego/utils/bitarray.hpp"
 #include "imagestego/utils/jpeg_image.hpp"
-#ifdef IMAGESTEGO_ENABLE_KEYGEN_SUPPORT
-#include "imagestego/keygen.hpp"
-#include <iostream>
-#endif
-#ifdef IMAGESTEGO_ENABLE_FORMAT_CHECKNG
-#include "imagestego/utils/format_checker.hpp"
-#endif
 // c++
 #include <string>
 #include <vector>
 
 namespace imagestego {
 
-#ifdef IMAGESTEGO_COMPRESSION_SUPPORT
-template<typename EncoderType>
-class JpegLsbEmbedder : public AbstractStegoEmbedder {
-public:
-    explicit JpegLsbEmbedder() noexcept {}
-    explicit JpegLsbEmbedder(const std::string& input, const std::string& _output)
-        : image(input), output(_output) {}
-    void setImage(const std::string& img) override { image.open(img); }
-    void setOutputName(const std::string& str) override { output = str; }
-    void setMessage(const std::string& message) override {
-        encoder.setMessage(message);
-        msg = encoder.getEncodedMessage();
-    }
-    void setSecretKey(const std::string& _key) override {
-        key = BitArray<unsigned char>(_key);
-    }
-    Algorithm getAlgorithm() const noexcept override { return Algorithm::JpegLsb; }
-    void createStegoContainer() override {
-        if (key.empty()) {
-#ifdef IMAGESTEGO_ENABLE_KEYGEN_SUPPORT
-            auto s = keygen::generate();
-            std::cout << "key = " << s << std::endl;
-            setSecretKey(s);
-#else
-            throw Exception(Exception::Codes::NoKeyFound);
-#endif
-        }
-        std::size_t keyIndex = 0, msgIndex = 0;
-        BitArray<uint32_t> sizeStream;
-        sizeStream.pushBack(msg.size(), 32);
-        int i = 0, j = 0;
-        for (; i != image.rows; ++i) {
-            for (j = 0; j != image.cols && msgIndex != 32; ++j) {
-                auto p = image.at(i, j);
-                if ((p[0] & 1) != key[keyIndex]) {
-                    if (p[1] != 1 && p[1]) {
-                        if (sizeStream[msgIndex++])
-                            p[1] |= 1;
-                        else
-                            p[1] &= ~1;
-                    }
-                } else {
-                    if (p[2] != 1 && p[2]) {
-                        if (sizeStream[msgIndex++])
-                            p[2] |= 1;
-                        else
-                            p[2] &= ~1;
-                    }
-                }
-                keyIndex = (keyIndex + 1) % key.size();
-            }
-            if (j == image.cols)
-                j = 0;
-            if (msgIndex == 32) {
-                if (!j)
-                    ++i;
-                break;
-            }
-        }
-        msgIndex = 0;
-        for (; i != image.rows && msgIndex != msg.size(); ++i) {
-            for (; j != image.cols && msgIndex != msg.size(); ++j) {
-                auto p = image.at(i, j);
-                if ((p[0] & 1) != key[keyIndex]) {
-                    if (p[1] != 1 && p[1]) {
-                        if (msg[msgIndex++])
-                            p[1] |= 1;
-                        else
-                            p[1] &= ~1;
-                    }
-                } else {
-                    if (p[2] != 1 && p[2]) {
-                        if (msg[msgIndex++])
-                            p[2] |= 1;
-                        else
-                            p[2] &= ~1;
-                    }
-                }
-                keyIndex = (keyIndex + 1) % key.size();
-            }
-            j = 0; // well it's important
-        }
-        image.writeTo(output);
-    }
-
-private:
-    BitArray<unsigned char> msg, key;
-    EncoderType encoder;
-    JpegImage image;
-    std::string output;
-}; // class JpegLsbEmbedder
-
-template<typename DecoderType>
-class JpegLsbExtracter : public AbstractStegoExtracter {
-public:
-    explicit JpegLsbExtracter() noexcept {}
-    explicit JpegLsbExtracter(const std::string& _image) : image(_image) {}
-    void setImage(const std::string& str) override { image.open(str); }
-    void setSecretKey(const std::string& _key) override { key = BitArray<>(_key); }
-    Algorithm getAlgorithm() const noexcept override { return Algorithm::JpegLsb; }
-    std::string extractMessage() override {
-        if (key.empty())
-            throw Exception(Exception::Codes::NoKeyFound);
-        std::size_t keyIndex = 0, msgIndex = 0;
-        BitArray<uint32_t> sizeStream;
-        BitArray<uint8_t> msg;
-        int i = 0, j = 0;
-        for (; i != image.rows; ++i) {
-            for (; j != image.cols && sizeStream.size() != 32; ++j) {
-                auto p = image.at(i, j);
-                if (lsb(p[0]) != key[keyIndex]) {
-                    if (p[1] != 1 && p[1])
-                        sizeStream.pushBack(lsb(p[1]));
-                } else {
-                    if (p[2] != 1 && p[2])
-                        sizeStream.pushBack(lsb(p[2]));
-                }
-                keyIndex = (keyIndex + 1) % key.size();
-            }
-            if (j == image.cols)
-                j = 0;
-            if (sizeStream.size() == 32) {
-                if (!j)
-                    ++i;
-                break;
-            }
-        }
-        std::size_t sz = sizeStream.getBlock(0);
-        for (; i != image.rows && sz; ++i) {
-            for (; j != image.cols && sz; ++j) {
-                auto p = image.at(i, j);
-                if (lsb(p[0]) != key[keyIndex]) {
-                    if (p[1] != 1 && p[1]) {
-                        msg.pushBack(lsb(p[1]));
-                        --sz;
-                    }
-                } else {
-                    if (p[2] != 1 && p[2]) {
-                        msg.pushBack(lsb(p[2]));
-                        --sz;
-                    }
-                }
-                keyIndex = (keyIndex + 1) % key.size();
-            }
-        }
-        decoder.setMessage(msg);
-        return decoder.getDecodedMessage();
-    }
-
-private:
-    BitArray<> key;
-    JpegImage image;
-    DecoderType decoder;
-    static constexpr bool lsb(const short& value) { return (value & 1) != 0; }
-}; // class JpegLsbExtracter
-#else
 template<class EncoderType>
 class JpegLsbEmbedder;
 
 template<class DecoderType>
 class JpegLsbExtracter;
-#endif /* IMAGESTEGO_COMPRESSION_SUPPORT */
 
 template<>
-class IMAGESTEGO_EXPORTS JpegLsbEmbedder<void> : public AbstractStegoEmbedder {
+class IMAGESTEGO_EXPORTS JpegLsbEmbedder<void> : public StegoEmbedder {
 public:
     explicit JpegLsbEmbedder() noexcept;
-    explicit JpegLsbEmbedder(const std::string& input, const std::string& _output);
+    explicit JpegLsbEmbedder(const std::string& input);
     void setImage(const std::string&) override;
-    void setOutputName(const std::string& str) override;
+    void setImage(const std::vector<uint8_t>& buf) override;
     void setMessage(const std::string& message) override;
     void setSecretKey(const std::string& key) override;
-    Algorithm getAlgorithm() const noexcept override;
-    void createStegoContainer() override;
+    void createStegoContainer(const std::string& dst) override;
+    // container is always JPEG, ext is ignored
+    void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) override;
+    // number of message bits which fit into image
+    static std::size_t capacity(const JpegImage& image);
+
+protected:
+    // bits to be embedded, set by setMessage()
+    BitArray msg;
 
 private:
-    BitArray<> msg, key;
+    BitArray key;
     JpegImage image;
-    std::string output;
+    void embed();
 }; // class JpegLsbEmbedder
 
 template<>
-class IMAGESTEGO_EXPORTS JpegLsbExtracter<void> : public AbstractStegoExtracter {
+class IMAGESTEGO_EXPORTS JpegLsbExtracter<void> : public StegoExtracter {
 public:
     explicit JpegLsbExtracter() noexcept;
     explicit JpegLsbExtracter(const std::string& image);
     void setImage(const std::string& str) override;
+    void setImage(const std::vector<uint8_t>& buf) override;
     void setSecretKey(const std::string& key) override;
-    Algorithm getAlgorithm() const noexcept override;
     std::string extractMessage() override;
 
+protected:
+    // embedded bits as they were set by embedder
+    BitArray extractBits();
+
 private:
-    BitArray<> key;
+    BitArray key;
     JpegImage image;
 }; // class JpegLsbExtracter
 
+#ifdef IMAGESTEGO_COMPRESSION_SUPPORT
+// message is compressed by EncoderType, embedding is the same as in
+// JpegLsbEmbedder<void>
+template<class EncoderType>
+class JpegLsbEmbedder : public JpegLsbEmbedder<void> {
+public:
+    using JpegLsbEmbedder<void>::JpegLsbEmbedder;
+    void setMessage(const std::string& message) override {
+        encoder.setMessage(message);
+        msg = encoder.getEncodedMessage();
+    }
+
+private:
+    EncoderType encoder;
+}; // class JpegLsbEmbedder
+
+template<class DecoderType>
+class JpegLsbExtracter : public JpegLsbExtracter<void> {
+public:
+    using JpegLsbExtracter<void>::JpegLsbExtracter;
+    std::string extractMessage() override {
+        decoder.setMessage(extractBits());
+        return decoder.getDecodedMessage();
+    }
+
+private:
+    DecoderType decoder;
+}; // class JpegLsbExtracter
+#endif /* IMAGESTEGO_COMPRESSION_SUPPORT */
+
 } // namespace imagestego
 
 #endif /* __IMAGESTEGO_JPEG_LSB_HPP_INCLUDED__ */
@@ -4,6 +4,7 @@
 // imagestego headers
 #include "imagestego/core.hpp"
 // c++ headers
+#include <csetjmp>
 #include <cstdio>
 #include <string>
 #include <tuple>
@@ -31,25 +32,114 @@ struct Point {
     operator Point_() const { return Point_(x, y, z); }
 }; // struct Point
 
-class JpegImage {
+// libjpeg error manager jumping back into the running JpegImage call instead of
+// calling exit(), default handler is used when no call has set the jump
+struct JpegError {
+    jpeg_error_mgr mgr;
+    std::jmp_buf jump;
+    bool armed = false;
+}; // struct JpegError
+
+// rows of 8x8 coefficient blocks covering the same 8 rows of image points,
+// blocks of each component are contiguous
+struct BlockRow {
+    JBLOCKROW blocks[3];
+    // sampling factors of components and the largest ones
+    int h[3], v[3], hmax, vmax;
+    // coefficient of image point (y, x) lying in this row, points of subsampled
+    // component share its coefficients
+    inline JCOEF& at(int component, int y, int x) const noexcept {
+        y = y * v[component] / vmax;
+        x = x * h[component] / hmax;
+        return blocks[component][x / 8][(y % 8) * 8 + (x % 8)];
+    }
+}; // struct BlockRow
+
+class IMAGESTEGO_EXPORTS JpegImage {
 public:
     int rows, cols;
 
     explicit JpegImage() noexcept;
     explicit JpegImage(const std::string& src);
+    explicit JpegImage(const std::vector<uint8_t>& buf);
     virtual ~JpegImage() noexcept;
     void open(const std::string& src);
+    // buffer is copied, so it may be released right after the call
+    void open(const std::vector<uint8_t>& buf);
     void close() noexcept;
     inline bool isEmpty() const noexcept { return coeffs == nullptr; }
     Point at(const int& y, const int& x);
     Point_ at(const int& y, const int& x) const;
+    // realizes row of blocks of every component, valid until the next call
+    BlockRow blockRow(int row);
+    // same as above, but row isn't marked as modified
+    BlockRow blockRow(int row) const;
+    inline int components() const noexcept { return dinfo.num_components; }
+    // size of component in blocks, subsampled components are smaller
+    inline int blockRows(int component) const noexcept {
+        return static_cast<int>(dinfo.comp_info[component].height_in_blocks);
+    }
+    inline int blockCols(int component) const noexcept {
+        return static_cast<int>(dinfo.comp_info[component].width_in_blocks);
+    }
+    // realizes row of blocks of single component, valid until the next call
+    JBLOCKROW blockRow(int component, int row);
+    const JBLOCK* blockRow(int component, int row) const;
+    // calls f for every coefficient of component in memory order while it returns
+    // true, returns false if f stopped traversal
+    template<class Function>
+    bool forEach(int component, Function f) {
+        for (int r = 0; r != blockRows(component); ++r) {
+            JCOEF* c = blockRow(component, r)[0];
+            for (int i = 0; i != blockCols(component) * DCTSIZE2; ++i)
+                if (!f(c[i]))
+                    return false;
+        }
+        return true;
+    }
+    template<class Function>
+    bool forEach(int component, Function f) const {
+        for (int r = 0; r != blockRows(component); ++r) {
+            const JCOEF* c = blockRow(component, r)[0];
+            for (int i = 0; i != blockCols(component) * DCTSIZE2; ++i)
+                if (!f(c[i]))
+                    return false;
+        }
+        return true;
+    }
+    // same as above for all components one by one
+    template<class Function>
+    bool forEach(Function f) {
+        for (int k = 0; k != components(); ++k)
+            if (!forEach(k, f))
+                return false;
+        return true;
+    }
+    template<class Function>
+    bool forEach(Function f) const {
+        for (int k = 0; k != components(); ++k)
+            if (!forEach(k, f))
+                return false;
+        return true;
+    }
     void writeTo(const std::string& dst);
+    void writeTo(std::vector<uint8_t>& dst);
 
 private:
     FILE* in = nullptr;
+    // source of image opened from memory
+    std::vector<uint8_t> buf;
     jvirt_barray_ptr* coeffs = nullptr;
     mutable jpeg_decompress_struct dinfo;
-    jpeg_error_mgr err;
+    JpegError err;
+    // sampling factors of components, blocks aren't set
+    BlockRow sampling() const noexcept;
+    // row of blocks realized by the last at() call
+    mutable int lastRow = -1;
+    mutable BlockRow lastBlocks;
+    void read();
+    void write(jpeg_compress_struct& cinfo);
+    jpeg_error_mgr* errorManager() noexcept;
 }; // class JpegImage
 
 } // namespace imagestego
@@ -1,37 +1,173 @@
 #include "imagestego/algorithms/f3.hpp"
+#include "randomize.hpp"
+// c++ headers
+#include <algorithm>
 
 namespace imagestego {
 
+namespace {
+
+// row of blocks of single component, rows of all components follow each other
+struct Line {
+    JCOEF* coeffs;
+    int size;
+};
+
+// coefficients copied out of virtual arrays: only a part of rows may be kept in
+// memory and pointers to realized rows are valid until the next access, so
+// threads work on the copy and rows are written back on the calling thread
+struct Lines {
+    std::vector<JCOEF> coeffs;
+    std::vector<Line> lines;
+};
+
+Lines copyLines(const JpegImage& image) {
+    Lines res;
+    std::size_t total = 0;
+    for (int k = 0; k != image.components(); ++k)
+        total += static_cast<std::size_t>(image.blockRows(k)) * image.blockCols(k);
+    res.coeffs.resize(total * DCTSIZE2);
+    JCOEF* dst = res.coeffs.data();
+    for (int k = 0; k != image.components(); ++k)
+        for (int r = 0; r != image.blockRows(k); ++r) {
+            const int size = image.blockCols(k) * DCTSIZE2;
+            const JCOEF* src = image.blockRow(k, r)[0];
+            std::copy(src, src + size, dst);
+            res.lines.push_back({dst, size});
+            dst += size;
+        }
+    return res;
+}
+
+void writeLines(JpegImage& image, const Lines& lines) {
+    auto line = lines.lines.begin();
+    for (int k = 0; k != image.components(); ++k)
+        for (int r = 0; r != image.blockRows(k); ++r, ++line)
+            std::copy(line->coeffs, line->coeffs + line->size, image.blockRow(k, r)[0]);
+}
+
+// number of bits enough for values up to n
+int bitWidth(std::size_t n) noexcept {
+    int width = 1;
+    while (n >>= 1)
+        ++width;
+    return width;
+}
+
+// number of coefficients which carry a bit regardless of shrinkage
+std::size_t guaranteed(const Line* first, const Line* last) noexcept {
+    std::size_t count = 0;
+    for (; first != last; ++first)
+        for (int i = 0; i != first->size; ++i)
+            if (first->coeffs[i] > 1 || first->coeffs[i] < -1)
+                ++count;
+    return count;
+}
+
+void append(std::vector<bool>& bits, uint64_t value, int n) {
+    while (n--)
+        bits.push_back(((value >> n) & 1) != 0);
+}
+
+// embeds count bits returned by bit(idx) into lines, returns false if they don't fit
+template<class Function>
+bool embedLines(const Line* first, const Line* last, std::size_t count, Function bit) {
+    if (!count)
+        return true;
+    std::size_t idx = 0;
+    for (; first != last; ++first)
+        for (JCOEF *c = first->coeffs, *end = c + first->size; c != end; ++c) {
+            if (!*c)
+                continue;
+            if (((*c & 1) != 0) != bit(idx)) {
+                // shrinkage, the same bit goes to the next coefficient
+                if (*c == 1 || *c == -1) {
+                    *c = 0;
+                    continue;
+                }
+                *c += (*c > 0) ? -1 : 1;
+            }
+            if (++idx == count)
+                return true;
+        }
+    return false;
+}
+
+// sequential reader of bits embedded into lines
+class Reader {
+public:
+    Reader(const Line* first, const Line* last) noexcept : line(first), last(last) {}
+    // next n bits, the most significant one goes first
+    uint64_t read(int n) {
+        uint64_t value = 0;
+        while (n) {
+            if (line == last)
+                throw Exception(Exception::Codes::CorruptedMessage);
+            if (pos == line->size) {
+                ++line;
+                pos = 0;
+                continue;
+            }
+            const JCOEF c = line->coeffs[pos++];
+            if (c) {
+                value = (value << 1) | static_cast<uint64_t>(c & 1);
+                --n;
+            }
+        }
+        return value;
+    }
+
+private:
+    const Line* line;
+    const Line* last;
+    int pos = 0;
+}; // class Reader
+
+} // namespace
+
 F3Embedder<void>::F3Embedder() noexcept {}
 
-F3Embedder<void>::F3Embedder(const std::string& input, const std::string& _output)
-    : image(input), output(_output) {}
+F3Embedder<void>::F3Embedder(const std::string& input) : image(input) {}
 
 void F3Embedder<void>::setImage(const std::string& imageName) { image.open(imageName); }
 
-void F3Embedder<void>::setOutputName(const std::string& filename) { output = filename; }
+void F3Embedder<void>::setImage(const std::vector<uint8_t>& buf) { image.open(buf); }
 
-void F3Embedder<void>::setMessage(const std::string& _msg) { msg = BitArray<>(_msg); }
+void F3Embedder<void>::setMessage(const std::string& _msg) {
+    msg = BitArray::fromByteString(_msg);
+}
 
 void F3Embedder<void>::setSecretKey(const std::string& key) {
     gen.seed(hash(key));
     hasKey = true;
 }
 
-Algorithm F3Embedder<void>::getAlgorithm() const noexcept { return Algorithm::F3; }
+void F3Embedder<void>::createStegoContainer(const std::string& dst) {
+    embed();
+    image.writeTo(dst);
+}
+
+void F3Embedder<void>::createStegoContainer(std::vector<uint8_t>& dst, const std::string&) {
+    embed();
+    image.writeTo(dst);
+}
 
-void F3Embedder<void>::createStegoContainer() {
-    if (!hasKey) {
-#ifdef IMAGESTEGO_ENABLE_KEYGEN_SUPPORT
-        auto s = keygen::generate();
-        std::cout << "key = " << s << std::endl;
-        setSecretKey(s);
-#else
+void F3Embedder<void>::embed() {
+    if (!hasKey)
         throw Exception(Exception::Codes::NoKeyFound);
-#endif
+    if (parallel) {
+        embedParallel();
+        return;
     }
-    randomize(msg, gen);
-    msg.put('\0');
+    // checked up front: once coefficients are changed the image can't be restored
+    if (msg.size() > capacity(image))
+        throw Exception(Exception::Codes::BigMessageSize);
+    // 32-bit size goes first, the whole stream is xored with keyed one
+    BitArray bits;
+    bits.put(msg.size(), 32);
+    for (std::size_t i = 0; i != msg.size(); ++i)
+        bits.pushBack(msg[i]);
+    randomize(bits, gen);
     auto lsb = [](const short& value) -> bool { return (value & 1) != 0; };
     auto decrement = [](short& value) -> void {
         if (value > 0)
@@ -40,28 +176,98 @@ void F3Embedder<void>::createStegoContainer() {
             ++value;
     };
     std::size_t msgIndex = 0;
-    for (int i = 0; i != image.rows; ++i) {
-        for (int j = 0; j != image.cols; ++j) {
-            auto p = image.at(i, j);
-            for (char k = 0; k != 3; ++k) {
-                if (p[k]) {
-                    if (lsb(p[k]) != msg[msgIndex]) {
-                        if (p[k] == 1 || p[k] == -1)
-                            p[k] = 0;
-                        else {
-                            decrement(p[k]);
-                            ++msgIndex;
-                        }
-                    } else
-                        ++msgIndex;
-                }
-                if (msgIndex == msg.size()) {
-                    image.writeTo(output);
-                    return;
+    // components are scanned one by one over their own block grids, so
+    // subsampled chroma is neither skipped nor read out of bounds
+    image.forEach([&](short& c) -> bool {
+        if (c) {
+            if (lsb(c) != bits[msgIndex]) {
+                if (c == 1 || c == -1)
+                    c = 0;
+                else {
+                    decrement(c);
+                    ++msgIndex;
                 }
-            }
+            } else
+                ++msgIndex;
         }
+        return msgIndex != bits.size();
+    });
+}
+
+void F3Embedder<void>::setParallel(bool enabled) noexcept { parallel = enabled; }
+
+void F3Embedder<void>::embedParallel() {
+    Lines copy = copyLines(image);
+    const std::vector<Line>& all = copy.lines;
+    const Line* data = all.data();
+    std::size_t coefficients = 0;
+    for (const auto& line : all)
+        coefficients += line.size;
+    const int lineWidth = bitWidth(all.size()), lengthWidth = bitWidth(coefficients);
+    std::size_t count = std::min<std::size_t>(
+        {255, 4 * sharedThreadPool().size(), all.size()});
+    // header goes first: number of segments, first line of segments and length of
+    // every segment, lines enough for it regardless of shrinkage are reserved
+    std::size_t start = 0;
+    for (std::size_t cap = 0; cap < 8 + lineWidth + count * lengthWidth; ++start) {
+        if (start == all.size())
+            throw Exception(Exception::Codes::BigMessageSize);
+        cap += guaranteed(data + start, data + start + 1);
+    }
+    count = std::min(count, all.size() - start);
+    if (!count)
+        throw Exception(Exception::Codes::BigMessageSize);
+    // rest of lines is split evenly into ranges, one per segment
+    auto range = [&](std::size_t i) {
+        return data + start + (all.size() - start) * i / count;
+    };
+    std::vector<std::size_t> capacity(count);
+    parallelFor(count,
+                [&](std::size_t i) { capacity[i] = guaranteed(range(i), range(i + 1)); });
+    // keyed assignment of segments to ranges
+    const Permutation perm(count, gen);
+    randomize(msg, gen);
+    std::size_t total = 0;
+    for (auto cap : capacity)
+        total += cap;
+    if (msg.size() > total)
+        throw Exception(Exception::Codes::BigMessageSize);
+    // every segment takes share of message proportional to capacity of its range,
+    // so it fits regardless of shrinkage
+    std::vector<std::size_t> bounds(count + 1, 0);
+    for (std::size_t j = 0, cap = 0; j != count; ++j) {
+        bounds[j] = total ? static_cast<uint64_t>(msg.size()) * cap / total : 0;
+        cap += capacity[perm[j]];
     }
+    bounds[count] = msg.size();
+    std::vector<bool> header;
+    append(header, count, 8);
+    append(header, start, lineWidth);
+    for (std::size_t j = 0; j != count; ++j)
+        append(header, bounds[j + 1] - bounds[j], lengthWidth);
+    if (!embedLines(data, data + start, header.size(),
+                    [&](std::size_t idx) -> bool { return header[idx]; }))
+        throw Exception(Exception::Codes::InternalError);
+    const BitArray& bits = msg;
+    parallelFor(count, [&](std::size_t j) {
+        const std::size_t r = perm[j];
+        if (!embedLines(range(r), range(r + 1), bounds[j + 1] - bounds[j],
+                        [&](std::size_t idx) -> bool { return bits[bounds[j] + idx]; }))
+            throw Exception(Exception::Codes::InternalError);
+    });
+    writeLines(image, copy);
+}
+
+std::size_t F3Embedder<void>::capacity(const JpegImage& image) {
+    // coefficients equal to +-1 may shrink to zero and carry nothing,
+    // the first 32 bits are taken by message size
+    std::size_t count = 0;
+    image.forEach([&](const short& c) -> bool {
+        if (c > 1 || c < -1)
+            ++count;
+        return true;
+    });
+    return (count > 32) ? count - 32 : 0;
 }
 
 F3Extracter<void>::F3Extracter() noexcept {}
@@ -70,33 +276,80 @@ F3Extracter<void>::F3Extracter(const std::string& input) : image(input) {}
 
 void F3Extracter<void>::setImage(const std::string& imageName) { image.open(imageName); }
 
+void F3Extracter<void>::setImage(const std::vector<uint8_t>& buf) { image.open(buf); }
+
 void F3Extracter<void>::setSecretKey(const std::string& key) {
     gen.seed(hash(key));
     hasKey = true;
 }
 
-Algorithm F3Extracter<void>::getAlgorithm() const noexcept { return Algorithm::F3; }
+std::string F3Extracter<void>::extractMessage() { return extractBits().toByteString(); }
 
-std::string F3Extracter<void>::extractMessage() {
+BitArray F3Extracter<void>::extractBits() {
     if (!hasKey)
         throw Exception(Exception::Codes::NoKeyFound);
+    if (parallel)
+        return extractParallel();
     auto lsb = [](const short& value) -> bool { return (value & 1) != 0; };
-    BitArray<uint8_t> msg;
-    for (int i = 0; i != image.rows; ++i) {
-        for (int j = 0; j != image.cols; ++j) {
-            auto p = image.at(i, j);
-            for (char k = 0; k != 3; ++k) {
-                if (p[k])
-                    msg.pushBack(lsb(p[k]));
-                if (msg.size() && msg.size() % 8 == 0 && msg.lastBlock() == 0) {
-                    randomize(msg, gen);
-                    auto s = msg.toString();
-                    s.pop_back();
-                    return s;
-                }
-            }
-        }
-    }
+    BitArray header, msg;
+    std::size_t size = 0;
+    // stops when 32-bit size and as many bits of message are read
+    const bool complete = !static_cast<const JpegImage&>(image).forEach(
+        [&](const short& c) -> bool {
+            if (!c)
+                return true;
+            if (header.size() != 32) {
+                header.pushBack(lsb(c));
+                if (header.size() != 32)
+                    return true;
+                randomize(header, gen);
+                size = header.readBits(0, 32);
+            } else
+                msg.pushBack(lsb(c));
+            return msg.size() != size;
+        });
+    if (!complete)
+        throw Exception(Exception::Codes::CorruptedMessage);
+    randomize(msg, gen);
+    return msg;
+}
+
+void F3Extracter<void>::setParallel(bool enabled) noexcept { parallel = enabled; }
+
+BitArray F3Extracter<void>::extractParallel() {
+    const Lines copy = copyLines(image);
+    const std::vector<Line>& all = copy.lines;
+    const Line* data = all.data();
+    std::size_t coefficients = 0;
+    for (const auto& line : all)
+        coefficients += line.size;
+    const int lineWidth = bitWidth(all.size()), lengthWidth = bitWidth(coefficients);
+    Reader header(data, data + all.size());
+    const std::size_t count = header.read(8);
+    const std::size_t start = header.read(lineWidth);
+    if (!count || start >= all.size() || count > all.size() - start)
+        throw Exception(Exception::Codes::CorruptedMessage);
+    std::vector<std::size_t> lengths(count);
+    for (auto& length : lengths)
+        length = header.read(lengthWidth);
+    auto range = [&](std::size_t i) {
+        return data + start + (all.size() - start) * i / count;
+    };
+    const Permutation perm(count, gen);
+    std::vector<std::vector<bool>> segments(count);
+    parallelFor(count, [&](std::size_t j) {
+        const std::size_t r = perm[j];
+        Reader reader(range(r), range(r + 1));
+        segments[j].reserve(lengths[j]);
+        for (std::size_t i = 0; i != lengths[j]; ++i)
+            segments[j].push_back(reader.read(1) != 0);
+    });
+    BitArray msg;
+    for (const auto& segment : segments)
+        for (bool bit : segment)
+            msg.pushBack(bit);
+    randomize(msg, gen);
+    return msg;
 }
 
 } // namespace imagestego
@@ -0,0 +1,168 @@
+#include "imagestego/algorithms/f5.hpp"
+#include "randomize.hpp"
+#include "syndrome.hpp"
+
+namespace imagestego {
+
+namespace {
+
+// header holds k of matrix encoding and message size in bits, it's embedded with k = 1
+const int rateBits = 4;
+const int sizeBits = 32;
+// groups beyond 2^9 - 1 coefficients carry almost nothing more per change
+const int maxRate = 9;
+
+// AC coefficients of all components, DC ones are never changed
+template<class Coeff, class Image>
+std::vector<Coeff*> coefficients(Image& image) {
+    std::vector<Coeff*> res;
+    int i = 0;
+    image.forEach([&](Coeff& c) -> bool {
+        if (i++ % DCTSIZE2)
+            res.push_back(&c);
+        return true;
+    });
+    return res;
+}
+
+} // namespace
+
+F5Embedder<void>::F5Embedder() noexcept {}
+
+F5Embedder<void>::F5Embedder(const std::string& input) : image(input) {}
+
+void F5Embedder<void>::setImage(const std::string& imageName) { image.open(imageName); }
+
+void F5Embedder<void>::setImage(const std::vector<uint8_t>& buf) { image.open(buf); }
+
+void F5Embedder<void>::setMessage(const std::string& _msg) {
+    msg = BitArray::fromByteString(_msg);
+}
+
+void F5Embedder<void>::setSecretKey(const std::string& key) {
+    gen.seed(hash(key));
+    hasKey = true;
+}
+
+void F5Embedder<void>::createStegoContainer(const std::string& dst) {
+    embed();
+    image.writeTo(dst);
+}
+
+void F5Embedder<void>::createStegoContainer(std::vector<uint8_t>& dst,
+                                            const std::string&) {
+    embed();
+    image.writeTo(dst);
+}
+
+void F5Embedder<void>::embed() {
+    if (!hasKey)
+        throw Exception(Exception::Codes::NoKeyFound);
+    // keyed stream is drawn from a copy, so failed call leaves embedder as it was
+    std::mt19937 g = gen;
+    const std::vector<JCOEF*> coeffs = coefficients<JCOEF>(image);
+    const Permutation perm(coeffs.size(), g);
+    const uint32_t rateMask = g(), sizeMask = g();
+    BitArray bits = msg;
+    randomize(bits, g);
+    // coefficients in keyed order, image is changed only after the whole message fits
+    std::vector<JCOEF> values(coeffs.size());
+    // embeds with given k into values, false if nonzero coefficients run out
+    auto attempt = [&](int rate) -> bool {
+        for (std::size_t i = 0; i != coeffs.size(); ++i)
+            values[i] = *coeffs[perm[i]];
+        auto writer = syndromeWriter<JCOEF>(
+            [&](std::size_t i) -> JCOEF& { return values[i]; }, values.size());
+        const uint32_t r = static_cast<uint32_t>(rate) ^ (rateMask & ((1u << rateBits) - 1));
+        for (int i = rateBits - 1; i >= 0; --i)
+            if (!writer.write(1, (r >> i) & 1))
+                return false;
+        const uint32_t size = static_cast<uint32_t>(bits.size()) ^ sizeMask;
+        for (int i = sizeBits - 1; i >= 0; --i)
+            if (!writer.write(1, (size >> i) & 1))
+                return false;
+        // the last group is padded with zeros
+        for (std::size_t i = 0; i < bits.size(); i += rate) {
+            uint32_t value = 0;
+            for (std::size_t j = i; j != i + rate; ++j)
+                value = (value << 1) | ((j < bits.size() && bits[j]) ? 1 : 0);
+            if (!writer.write(rate, value))
+                return false;
+        }
+        changed = writer.changes();
+        return true;
+    };
+    const std::size_t usable = capacity(image);
+    // the largest k whose groups are expected to fit, it gives the fewest changes
+    auto fits = [&](int rate) {
+        return (bits.size() + rate - 1) / rate * ((std::size_t(1) << rate) - 1) <= usable;
+    };
+    int rate = 1;
+    while (rate != maxRate && fits(rate + 1))
+        ++rate;
+    // capacity is an estimate: more coefficients may shrink, then smaller k is tried
+    while (!attempt(rate))
+        if (--rate == 0)
+            throw Exception(Exception::Codes::BigMessageSize);
+    for (std::size_t i = 0; i != coeffs.size(); ++i)
+        *coeffs[perm[i]] = values[i];
+    k = rate;
+    gen = g;
+}
+
+std::size_t F5Embedder<void>::capacity(const JpegImage& image) {
+    // about half of +-1 coefficients are expected to shrink to zero
+    std::size_t nonzero = 0, ones = 0;
+    const std::vector<const JCOEF*> coeffs = coefficients<const JCOEF>(image);
+    for (const JCOEF* c : coeffs) {
+        if (*c)
+            ++nonzero;
+        if (*c == 1 || *c == -1)
+            ++ones;
+    }
+    const std::size_t header = rateBits + sizeBits;
+    return (nonzero - ones / 2 > header) ? nonzero - ones / 2 - header : 0;
+}
+
+F5Extracter<void>::F5Extracter() noexcept {}
+
+F5Extracter<void>::F5Extracter(const std::string& input) : image(input) {}
+
+void F5Extracter<void>::setImage(const std::string& imageName) { image.open(imageName); }
+
+void F5Extracter<void>::setImage(const std::vector<uint8_t>& buf) { image.open(buf); }
+
+void F5Extracter<void>::setSecretKey(const std::string& key) {
+    gen.seed(hash(key));
+    hasKey = true;
+}
+
+std::string F5Extracter<void>::extractMessage() {
+    if (!hasKey)
+        throw Exception(Exception::Codes::NoKeyFound);
+    const std::vector<const JCOEF*> coeffs =
+        coefficients<const JCOEF>(static_cast<const JpegImage&>(image));
+    const Permutation perm(coeffs.size(), gen);
+    const uint32_t rateMask = gen(), sizeMask = gen();
+    auto reader = syndromeReader<JCOEF>(
+        [&](std::size_t i) -> JCOEF { return *coeffs[perm[i]]; }, coeffs.size());
+    uint32_t rate = 0, size = 0;
+    for (int i = 0; i != rateBits; ++i)
+        rate = (rate << 1) | reader.read(1);
+    for (int i = 0; i != sizeBits; ++i)
+        size = (size << 1) | reader.read(1);
+    rate ^= rateMask & ((1u << rateBits) - 1);
+    size ^= sizeMask;
+    if (rate < 1 || rate > maxRate || size > coeffs.size() * rate)
+        throw Exception(Exception::Codes::CorruptedMessage);
+    BitArray msg;
+    while (msg.size() != size) {
+        const uint32_t value = reader.read(static_cast<int>(rate));
+        for (int j = static_cast<int>(rate) - 1; j >= 0 && msg.size() != size; --j)
+            msg.pushBack(((value >> j) & 1) != 0);
+    }
+    randomize(msg, gen);
+    return msg.toByteString();
+}
+
+} // namespace imagestego
@@ -1,4 +1,5 @@
 #include "imagestego/utils/jpeg_image.hpp"
+#include <csetjmp>
 #include <iostream>
 
 namespace imagestego {
@@ -26,77 +27,231 @@ const short& Point_::operator[](int index) const noexcept {
         return y;
 }
 
+namespace {
+
+// destination manager writing into std::vector, which is doubled whenever it's full
+struct VectorDestination {
+    jpeg_destination_mgr mgr;
+    std::vector<uint8_t>* buf;
+
+    static VectorDestination* get(j_compress_ptr cinfo) noexcept {
+        // mgr is the first member
+        return reinterpret_cast<VectorDestination*>(cinfo->dest);
+    }
+    static void init(j_compress_ptr cinfo) {
+        VectorDestination* dest = get(cinfo);
+        dest->buf->resize(1 << 16);
+        dest->mgr.next_output_byte = dest->buf->data();
+        dest->mgr.free_in_buffer = dest->buf->size();
+    }
+    static boolean grow(j_compress_ptr cinfo) {
+        // libjpeg calls it only when the whole buffer is filled
+        VectorDestination* dest = get(cinfo);
+        const std::size_t size = dest->buf->size();
+        dest->buf->resize(2 * size);
+        dest->mgr.next_output_byte = dest->buf->data() + size;
+        dest->mgr.free_in_buffer = dest->buf->size() - size;
+        return static_cast<boolean>(true);
+    }
+    static void term(j_compress_ptr cinfo) {
+        VectorDestination* dest = get(cinfo);
+        dest->buf->resize(dest->buf->size() - dest->mgr.free_in_buffer);
+    }
+}; // struct VectorDestination
+
+void errorExit(j_common_ptr info) {
+    // mgr is the first member
+    JpegError* err = reinterpret_cast<JpegError*>(info->err);
+    if (!err->armed) {
+        // nowhere to jump, default handler prints message and exits
+        jpeg_error_mgr fallback;
+        jpeg_std_error(&fallback);
+        fallback.error_exit(info);
+    }
+    err->armed = false;
+    std::longjmp(err->jump, 1);
+}
+
+} // namespace
+
 JpegImage::JpegImage() noexcept {}
 
 JpegImage::JpegImage(const std::string& src) { open(src); }
 
+JpegImage::JpegImage(const std::vector<uint8_t>& buf) { open(buf); }
+
 JpegImage::~JpegImage() noexcept { close(); }
 
 void JpegImage::open(const std::string& src) {
-    if (in)
+    if (!isEmpty())
         close();
     in = fopen(src.c_str(), "rb");
     if (!in)
         throw Exception(Exception::Codes::NoSuchFile);
-    dinfo.err = jpeg_std_error(&err);
+    dinfo.err = errorManager();
+    jpeg_create_decompress(&dinfo);
+    read();
+}
+
+void JpegImage::open(const std::vector<uint8_t>& src) {
+    if (!isEmpty())
+        close();
+    // source manager refers to the buffer until decompression is finished
+    buf = src;
+    dinfo.err = errorManager();
     jpeg_create_decompress(&dinfo);
-    jpeg_stdio_src(&dinfo, in);
+    read();
+}
+
+jpeg_error_mgr* JpegImage::errorManager() noexcept {
+    jpeg_std_error(&err.mgr);
+    err.mgr.error_exit = &errorExit;
+    err.armed = false;
+    return &err.mgr;
+}
+
+void JpegImage::read() {
+    // libjpeg errors jump here, nothing with destructor lives in between
+    if (setjmp(err.jump)) {
+        jpeg_destroy_decompress(&dinfo);
+        if (in)
+            fclose(in);
+        in = nullptr;
+        coeffs = nullptr;
+        buf.clear();
+        throw Exception(Exception::Codes::CorruptedImage);
+    }
+    err.armed = true;
+    // image is opened either from file or from memory
+    if (in)
+        jpeg_stdio_src(&dinfo, in);
+    else
+        jpeg_mem_src(&dinfo, const_cast<unsigned char*>(buf.data()),
+                     static_cast<unsigned long>(buf.size()));
     jpeg_read_header(&dinfo, static_cast<boolean>(true));
     coeffs = jpeg_read_coefficients(&dinfo);
+    err.armed = false;
     rows = dinfo.image_height & ~7;
     cols = dinfo.image_width & ~7;
 }
 
 void JpegImage::close() noexcept {
-    jpeg_finish_decompress(&dinfo);
+    if (isEmpty())
+        return;
+    // error in trailing data doesn't matter, coefficients are read already
+    if (!setjmp(err.jump)) {
+        err.armed = true;
+        jpeg_finish_decompress(&dinfo);
+    }
+    err.armed = false;
     if (in)
         fclose(in);
     in = nullptr;
     jpeg_destroy_decompress(&dinfo);
+    coeffs = nullptr;
+    lastRow = -1;
+    buf.clear();
 }
 
 Point JpegImage::at(const int& y, const int& x) {
-    auto red = (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
-                                               coeffs[0], y / 8, 1,
-                                               static_cast<boolean>(true)),
-         green = (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
-                                                 coeffs[1], y / 8, 1,
-                                                 static_cast<boolean>(true)),
-         blue = (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
-                                                coeffs[2], y / 8, 1,
-                                                static_cast<boolean>(true));
-    return Point(red[0][x / 8][(y % 8) * 8 + (x % 8)],
-                 green[0][x / 8][(y % 8) * 8 + (x % 8)],
-                 blue[0][x / 8][(y % 8) * 8 + (x % 8)]);
+    // neighbouring points mostly lie in the same row of blocks
+    if (y / 8 != lastRow) {
+        lastBlocks = blockRow(y / 8);
+        lastRow = y / 8;
+    }
+    const BlockRow& row = lastBlocks;
+    return Point(row.at(0, y, x), row.at(1, y, x), row.at(2, y, x));
 }
 
 Point_ JpegImage::at(const int& y, const int& x) const {
-    auto red = (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
-                                               coeffs[0], y / 8, 1,
-                                               static_cast<boolean>(true)),
-         green = (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
-                                                 coeffs[1], y / 8, 1,
-                                                 static_cast<boolean>(true)),
-         blue = (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
-                                                coeffs[2], y / 8, 1,
-                                                static_cast<boolean>(true));
-    return Point_(red[0][x / 8][(y % 8) * 8 + (x % 8)],
-                  green[0][x / 8][(y % 8) * 8 + (x % 8)],
-                  blue[0][x / 8][(y % 8) * 8 + (x % 8)]);
+    return const_cast<JpegImage*>(this)->at(y, x);
+}
+
+BlockRow JpegImage::blockRow(int row) {
+    BlockRow blocks = sampling();
+    for (int k = 0; k != components(); ++k)
+        blocks.blocks[k] = blockRow(k, row * blocks.v[k] / blocks.vmax);
+    return blocks;
+}
+
+BlockRow JpegImage::blockRow(int row) const {
+    BlockRow blocks = sampling();
+    for (int k = 0; k != components(); ++k)
+        blocks.blocks[k] =
+            const_cast<JBLOCKROW>(blockRow(k, row * blocks.v[k] / blocks.vmax));
+    return blocks;
+}
+
+BlockRow JpegImage::sampling() const noexcept {
+    BlockRow blocks = {};
+    blocks.hmax = dinfo.max_h_samp_factor;
+    blocks.vmax = dinfo.max_v_samp_factor;
+    for (int k = 0; k != components(); ++k) {
+        blocks.h[k] = dinfo.comp_info[k].h_samp_factor;
+        blocks.v[k] = dinfo.comp_info[k].v_samp_factor;
+    }
+    return blocks;
+}
+
+JBLOCKROW JpegImage::blockRow(int component, int row) {
+    return (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
+                                           coeffs[component], row, 1,
+                                           static_cast<boolean>(true))[0];
+}
+
+const JBLOCK* JpegImage::blockRow(int component, int row) const {
+    return (dinfo.mem->access_virt_barray)(reinterpret_cast<j_common_ptr>(&dinfo),
+                                           coeffs[component], row, 1,
+                                           static_cast<boolean>(false))[0];
 }
 
 void JpegImage::writeTo(const std::string& dst) {
+    FILE* out = fopen(dst.c_str(), "wb");
+    if (!out)
+        throw Exception(Exception::Codes::NoSuchFile);
     jpeg_compress_struct cinfo;
-    cinfo.err = jpeg_std_error(&err);
+    cinfo.err = errorManager();
     jpeg_create_compress(&cinfo);
-    FILE* out = fopen(dst.c_str(), "wb");
     jpeg_stdio_dest(&cinfo, out);
+    try {
+        write(cinfo);
+    } catch (...) {
+        fclose(out);
+        throw;
+    }
+    fclose(out);
+}
+
+void JpegImage::writeTo(std::vector<uint8_t>& dst) {
+    jpeg_compress_struct cinfo;
+    cinfo.err = errorManager();
+    jpeg_create_compress(&cinfo);
+    VectorDestination dest;
+    dest.mgr.init_destination = &VectorDestination::init;
+    dest.mgr.empty_output_buffer = &VectorDestination::grow;
+    dest.mgr.term_destination = &VectorDestination::term;
+    dest.buf = &dst;
+    cinfo.dest = &dest.mgr;
+    try {
+        write(cinfo);
+    } catch (...) {
+        dst.clear();
+        throw;
+    }
+}
+
+void JpegImage::write(jpeg_compress_struct& cinfo) {
+    if (setjmp(err.jump)) {
+        jpeg_destroy_compress(&cinfo);
+        throw Exception(Exception::Codes::InternalError);
+    }
+    err.armed = true;
     jpeg_copy_critical_parameters(&dinfo, &cinfo);
     cinfo.input_components = 3;
     cinfo.in_color_space = dinfo.out_color_space;
     jpeg_write_coefficients(&cinfo, coeffs);
     jpeg_finish_compress(&cinfo);
-    fclose(out);
+    err.armed = false;
     jpeg_destroy_compress(&cinfo);
 }
 
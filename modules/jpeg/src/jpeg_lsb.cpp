@@ -4,48 +4,63 @@ namespace imagestego {
 
 JpegLsbEmbedder<void>::JpegLsbEmbedder() noexcept {}
 
-JpegLsbEmbedder<void>::JpegLsbEmbedder(const std::string& input,
-                                       const std::string& _output)
-    : image(input), output(_output) {}
+JpegLsbEmbedder<void>::JpegLsbEmbedder(const std::string& input) : image(input) {}
 
 void JpegLsbEmbedder<void>::setImage(const std::string& im) { image.open(im); }
 
+void JpegLsbEmbedder<void>::setImage(const std::vector<uint8_t>& buf) { image.open(buf); }
+
 void JpegLsbEmbedder<void>::setMessage(const std::string& _msg) {
-    msg = BitArray<>(_msg);
+    msg = BitArray::fromByteString(_msg);
 }
 
-void JpegLsbEmbedder<void>::setOutputName(const std::string& str) { output = str; }
-
 void JpegLsbEmbedder<void>::setSecretKey(const std::string& _key) {
-    key = BitArray<>(_key);
+    key = BitArray::fromByteString(_key);
+}
+
+void JpegLsbEmbedder<void>::createStegoContainer(const std::string& dst) {
+    embed();
+    image.writeTo(dst);
 }
 
-Algorithm JpegLsbEmbedder<void>::getAlgorithm() const noexcept {
-    return Algorithm::JpegLsb;
+void JpegLsbEmbedder<void>::createStegoContainer(std::vector<uint8_t>& dst,
+                                                 const std::string&) {
+    embed();
+    image.writeTo(dst);
 }
 
-void JpegLsbEmbedder<void>::createStegoContainer() {
-    if (key.empty()) {
-#ifdef IMAGESTEGO_ENABLE_KEYGEN_SUPPORT
-        auto s = keygen::generate();
-        std::cout << "key = " << s << std::endl;
-        setSecretKey(s);
-#else
+void JpegLsbEmbedder<void>::embed() {
+    if (key.empty())
         throw Exception(Exception::Codes::NoKeyFound);
-#endif
-    }
-    msg.put('\0');
+    if (msg.size() > capacity(image))
+        throw Exception(Exception::Codes::BigMessageSize);
+    // 32-bit size goes first
+    BitArray bits;
+    bits.put(msg.size(), 32);
+    for (std::size_t i = 0; i != msg.size(); ++i)
+        bits.pushBack(msg[i]);
     std::size_t idx = 0;
-    for (int i = 0; i != image.rows && idx < msg.size(); ++i)
-        for (int j = 0; j != image.cols && idx < msg.size(); ++j) {
-            auto p = image.at(i, j);
-            if (p[0] != 1 && p[0] != 0)
-                if (msg[idx++])
-                    p[0] |= 1;
-                else
-                    p[0] &= ~1;
+    // only luma is used, its blocks are scanned as they lie in memory
+    image.forEach(0, [&](short& c) -> bool {
+        if (c != 1 && c != 0) {
+            if (bits[idx++])
+                c |= 1;
+            else
+                c &= ~1;
         }
-    image.writeTo(output);
+        return idx < bits.size();
+    });
+}
+
+std::size_t JpegLsbEmbedder<void>::capacity(const JpegImage& image) {
+    // the first 32 bits are taken by message size
+    std::size_t count = 0;
+    image.forEach(0, [&](const short& c) -> bool {
+        if (c != 1 && c != 0)
+            ++count;
+        return true;
+    });
+    return (count > 32) ? count - 32 : 0;
 }
 
 JpegLsbExtracter<void>::JpegLsbExtracter() noexcept {}
@@ -54,26 +69,38 @@ JpegLsbExtracter<void>::JpegLsbExtracter(const std::string& _image) : image(_ima
 
 void JpegLsbExtracter<void>::setImage(const std::string& str) { image.open(str); }
 
+void JpegLsbExtracter<void>::setImage(const std::vector<uint8_t>& buf) { image.open(buf); }
+
 void JpegLsbExtracter<void>::setSecretKey(const std::string& _key) {
-    key = BitArray<>(_key);
+    key = BitArray::fromByteString(_key);
 }
 
-Algorithm JpegLsbExtracter<void>::getAlgorithm() const noexcept {
-    return Algorithm::JpegLsb;
+std::string JpegLsbExtracter<void>::extractMessage() {
+    return extractBits().toByteString();
 }
 
-std::string JpegLsbExtracter<void>::extractMessage() {
+BitArray JpegLsbExtracter<void>::extractBits() {
     if (key.empty())
         throw Exception(Exception::Codes::NoKeyFound);
-    BitArray<unsigned char> arr;
-    for (int i = 0; i != image.rows; ++i)
-        for (int j = 0; j != image.cols; ++j) {
-            auto p = image.at(i, j);
-            if (p[0] != 1 && p[0] != 0)
-                arr.pushBack((p[0] & 1) != 0);
-            if (arr.size() && arr.size() % 8 == 0 && arr.lastBlock() == 0)
-                return arr.toString();
-        }
+    BitArray header, msg;
+    std::size_t size = 0;
+    const JpegImage& src = image;
+    // stops when 32-bit size and as many bits of message are read
+    const bool complete = !src.forEach(0, [&](const short& c) -> bool {
+        if (c == 1 || c == 0)
+            return true;
+        if (header.size() != 32) {
+            header.pushBack((c & 1) != 0);
+            if (header.size() != 32)
+                return true;
+            size = header.readBits(0, 32);
+        } else
+            msg.pushBack((c & 1) != 0);
+        return msg.size() != size;
+    });
+    if (!complete)
+        throw Exception(Exception::Codes::CorruptedMessage);
+    return msg;
 }
 
 } // namespace imagestego
@@ -0,0 +1,28 @@
+#ifndef __IMAGESTEGO_RANDOMIZE_HPP_INCLUDED__
+#define __IMAGESTEGO_RANDOMIZE_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core.hpp"
+// c++ headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+namespace imagestego {
+
+// xors bits with keyed stream, 32 bits per draw, applying it twice restores bits
+inline void randomize(BitArray& arr, std::mt19937& gen) {
+    BitArray res;
+    for (std::size_t i = 0; i < arr.size(); i += 32) {
+        const std::size_t n = std::min<std::size_t>(32, arr.size() - i);
+        const uint64_t mask = static_cast<uint32_t>(gen()) >> (32 - n);
+        res.appendBits(arr.readBits(i, n) ^ mask, n);
+    }
+    arr = std::move(res);
+}
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_RANDOMIZE_HPP_INCLUDED__ */
@@ -0,0 +1,100 @@
+#ifndef __IMAGESTEGO_SYNDROME_HPP_INCLUDED__
+#define __IMAGESTEGO_SYNDROME_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core.hpp"
+// c++ headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace imagestego {
+
+// negative coefficients carry inverted lsb, so decrementing absolute value of
+// coefficient of any sign flips its bit
+template<class Coeff>
+inline bool syndromeBit(Coeff c) noexcept {
+    return ((c & 1) != 0) == (c > 0);
+}
+
+// matrix encoding of F5: width bits go into the next 2^width - 1 nonzero coefficients
+// and at most one of them is changed, coefficients are taken as at(i), i < size
+template<class Coeff, class At>
+class SyndromeWriter {
+public:
+    explicit SyndromeWriter(At _at, std::size_t _size) : at(_at), size(_size) {}
+    // returns false if nonzero coefficients run out
+    bool write(int width, uint32_t value) {
+        const std::size_t n = (std::size_t(1) << width) - 1;
+        for (;;) {
+            group.clear();
+            std::size_t end = pos;
+            for (; end != size && group.size() != n; ++end) {
+                Coeff& c = at(end);
+                if (c)
+                    group.push_back(&c);
+            }
+            if (group.size() != n)
+                return false;
+            uint32_t syndrome = value;
+            for (std::size_t i = 0; i != n; ++i)
+                if (syndromeBit(*group[i]))
+                    syndrome ^= static_cast<uint32_t>(i + 1);
+            if (syndrome) {
+                Coeff& c = *group[syndrome - 1];
+                c += (c > 0) ? -1 : 1;
+                ++changed;
+                // shrinkage, the same value goes to the group gathered once again
+                if (!c)
+                    continue;
+            }
+            pos = end;
+            return true;
+        }
+    }
+    std::size_t changes() const noexcept { return changed; }
+
+private:
+    At at;
+    std::size_t size, pos = 0, changed = 0;
+    std::vector<Coeff*> group;
+}; // class SyndromeWriter
+
+template<class Coeff, class At>
+class SyndromeReader {
+public:
+    explicit SyndromeReader(At _at, std::size_t _size) : at(_at), size(_size) {}
+    // syndrome of the next 2^width - 1 nonzero coefficients
+    uint32_t read(int width) {
+        const std::size_t n = (std::size_t(1) << width) - 1;
+        uint32_t syndrome = 0;
+        for (std::size_t i = 0; i != n; ++pos) {
+            if (pos == size)
+                throw Exception(Exception::Codes::CorruptedMessage);
+            const Coeff c = at(pos);
+            if (c && syndromeBit(c))
+                syndrome ^= static_cast<uint32_t>(i + 1);
+            if (c)
+                ++i;
+        }
+        return syndrome;
+    }
+
+private:
+    At at;
+    std::size_t size, pos = 0;
+}; // class SyndromeReader
+
+template<class Coeff, class At>
+SyndromeWriter<Coeff, At> syndromeWriter(At at, std::size_t size) {
+    return SyndromeWriter<Coeff, At>(at, size);
+}
+
+template<class Coeff, class At>
+SyndromeReader<Coeff, At> syndromeReader(At at, std::size_t size) {
+    return SyndromeReader<Coeff, At>(at, size);
+}
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_SYNDROME_HPP_INCLUDED__ */
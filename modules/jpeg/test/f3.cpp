@@ -0,0 +1,253 @@
+// imagestego headers
+#include "imagestego/algorithms/f3.hpp"
+#include "imagestego/algorithms/jpeg_lsb.hpp"
+#ifdef IMAGESTEGO_COMPRESSION_SUPPORT
+#include "imagestego/compression/huffman_decoder.hpp"
+#include "imagestego/compression/huffman_encoder.hpp"
+#endif
+// c++ headers
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+// gtest
+#include <gtest/gtest.h>
+// libjpeg
+#include <jpeglib.h>
+
+using namespace imagestego;
+
+namespace {
+
+// test.jpg has 2x2 sampled luma, so every chroma coefficient covers 2x2 points
+bool subsampled(const JpegImage& image) {
+    return image.components() == 3 && image.blockCols(1) * 2 >= image.blockCols(0) &&
+           image.blockCols(1) < image.blockCols(0);
+}
+
+// number of coefficients of component carrying a bit regardless of shrinkage
+std::size_t guaranteed(const JpegImage& image, int component) {
+    std::size_t count = 0;
+    image.forEach(component, [&](const short& c) -> bool {
+        if (c > 1 || c < -1)
+            ++count;
+        return true;
+    });
+    return count;
+}
+
+std::string message(std::size_t size, std::mt19937& gen) {
+    std::string res(size, '\0');
+    for (auto& c : res)
+        c = static_cast<char>('a' + gen() % 26);
+    return res;
+}
+
+// noisy gradient compressed with given sampling factors of luma
+std::vector<uint8_t> makeJpeg(int width, int height, int h, int v, std::mt19937& gen) {
+    std::vector<JSAMPLE> pixels(static_cast<std::size_t>(width) * height * 3);
+    for (int y = 0; y != height; ++y)
+        for (int x = 0; x != width; ++x)
+            for (int k = 0; k != 3; ++k)
+                pixels[(y * width + x) * 3 + k] =
+                    static_cast<JSAMPLE>((x * (k + 1) + y * (3 - k) + gen() % 64) % 256);
+    jpeg_compress_struct cinfo;
+    jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    unsigned char* data = nullptr;
+    unsigned long size = 0;
+    jpeg_mem_dest(&cinfo, &data, &size);
+    cinfo.image_width = static_cast<JDIMENSION>(width);
+    cinfo.image_height = static_cast<JDIMENSION>(height);
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, 90, static_cast<boolean>(true));
+    cinfo.comp_info[0].h_samp_factor = h;
+    cinfo.comp_info[0].v_samp_factor = v;
+    jpeg_start_compress(&cinfo, static_cast<boolean>(true));
+    while (cinfo.next_scanline != cinfo.image_height) {
+        JSAMPROW row = &pixels[static_cast<std::size_t>(cinfo.next_scanline) * width * 3];
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    std::vector<uint8_t> res(data, data + size);
+    std::free(data);
+    return res;
+}
+
+// the longest message embedded in parallel mode and the container it went into
+std::string fillParallel(const std::vector<uint8_t>& image, std::vector<uint8_t>& container,
+                         std::mt19937& gen) {
+    std::size_t size = F3Embedder<void>::capacity(JpegImage(image)) / 8;
+    for (;; size -= size / 100 + 1) {
+        const std::string msg = message(size, gen);
+        F3Embedder<void> emb;
+        emb.setImage(image);
+        emb.setParallel(true);
+        emb.setSecretKey("key");
+        emb.setMessage(msg);
+        try {
+            emb.createStegoContainer(container, ".jpg");
+            return msg;
+        } catch (const Exception&) {
+        }
+    }
+}
+
+} // namespace
+
+TEST(Jpeg, F3Subsampled) {
+    const JpegImage image("test.jpg");
+    ASSERT_TRUE(subsampled(image));
+    // message spills over luma into both chroma components
+    const std::size_t luma = guaranteed(image, 0);
+    const std::size_t capacity = F3Embedder<void>::capacity(image);
+    ASSERT_GT(capacity, luma + guaranteed(image, 1));
+    std::mt19937 gen(42);
+    const std::string msg = message(capacity / 8 - 1, gen);
+
+    F3Embedder<void> emb("test.jpg");
+    emb.setMessage(msg);
+    emb.setSecretKey("key");
+    std::vector<uint8_t> container;
+    emb.createStegoContainer(container, ".jpg");
+
+    F3Extracter<void> ext;
+    ext.setImage(container);
+    ext.setSecretKey("key");
+    EXPECT_EQ(msg, ext.extractMessage());
+}
+
+#ifdef IMAGESTEGO_COMPRESSION_SUPPORT
+TEST(Jpeg, F3HuffmanSubsampled) {
+    const JpegImage image("test.jpg");
+    ASSERT_TRUE(subsampled(image));
+    const std::size_t luma = guaranteed(image, 0);
+    std::mt19937 gen(7);
+    // letters take about 5 bits each, so encoded message doesn't fit into luma
+    const std::string msg = message(luma / 4, gen);
+
+    F3Embedder<HuffmanEncoder> emb("test.jpg");
+    emb.setMessage(msg);
+    emb.setSecretKey("key");
+    std::vector<uint8_t> container;
+    emb.createStegoContainer(container, ".jpg");
+
+    F3Extracter<HuffmanDecoder> ext;
+    ext.setImage(container);
+    ext.setSecretKey("key");
+    EXPECT_EQ(msg, ext.extractMessage());
+}
+
+TEST(Jpeg, JpegLsbHuffmanSubsampled) {
+    std::mt19937 gen(13);
+    const std::string msg = message(1000, gen);
+
+    JpegLsbEmbedder<HuffmanEncoder> emb("test.jpg");
+    emb.setMessage(msg);
+    emb.setSecretKey("key");
+    std::vector<uint8_t> container;
+    emb.createStegoContainer(container, ".jpg");
+
+    JpegLsbExtracter<HuffmanDecoder> ext;
+    ext.setImage(container);
+    ext.setSecretKey("key");
+    EXPECT_EQ(msg, ext.extractMessage());
+}
+#endif /* IMAGESTEGO_COMPRESSION_SUPPORT */
+
+TEST(Jpeg, JpegLsbSubsampled) {
+    std::mt19937 gen(21);
+    const JpegImage image("test.jpg");
+    const std::string msg = message(JpegLsbEmbedder<void>::capacity(image) / 8, gen);
+
+    JpegLsbEmbedder<void> emb("test.jpg");
+    emb.setMessage(msg);
+    emb.setSecretKey("key");
+    std::vector<uint8_t> container;
+    emb.createStegoContainer(container, ".jpg");
+
+    JpegLsbExtracter<void> ext;
+    ext.setImage(container);
+    ext.setSecretKey("key");
+    EXPECT_EQ(msg, ext.extractMessage());
+}
+
+TEST(Jpeg, F3BigMessage) {
+    std::mt19937 gen(34);
+    const JpegImage image("test.jpg");
+    const std::size_t capacity = F3Embedder<void>::capacity(image);
+    const std::string msg = message(capacity / 8 + 1, gen);
+
+    F3Embedder<void> emb("test.jpg");
+    emb.setSecretKey("key");
+    emb.setMessage(msg);
+    std::vector<uint8_t> container;
+    EXPECT_THROW(emb.createStegoContainer(container, ".jpg"), Exception);
+    // failed attempt leaves image and keyed stream as they were
+    emb.setMessage("message");
+    emb.createStegoContainer(container, ".jpg");
+
+    F3Embedder<void> ref("test.jpg");
+    ref.setSecretKey("key");
+    ref.setMessage("message");
+    std::vector<uint8_t> expected;
+    ref.createStegoContainer(expected, ".jpg");
+    EXPECT_EQ(expected, container);
+}
+
+TEST(Jpeg, JpegLsbBigMessage) {
+    std::mt19937 gen(55);
+    const JpegImage image("test.jpg");
+    const std::size_t capacity = JpegLsbEmbedder<void>::capacity(image);
+
+    JpegLsbEmbedder<void> emb("test.jpg");
+    emb.setSecretKey("key");
+    emb.setMessage(message(capacity / 8 + 1, gen));
+    std::vector<uint8_t> container;
+    EXPECT_THROW(emb.createStegoContainer(container, ".jpg"), Exception);
+}
+
+TEST(Jpeg, F3Parallel) {
+    std::mt19937 gen(89);
+    // 4:4:4, 4:2:2 and 4:2:0
+    const int sampling[][2] = {{1, 1}, {2, 1}, {2, 2}};
+    for (const auto& hv : sampling) {
+        const std::vector<uint8_t> image = makeJpeg(517, 389, hv[0], hv[1], gen);
+        const std::size_t capacity = F3Embedder<void>::capacity(JpegImage(image));
+        std::vector<uint8_t> container;
+        const std::string msg = fillParallel(image, container, gen);
+        // segment header and line granularity cost only a small part of capacity
+        EXPECT_GT(msg.size() * 8, capacity * 9 / 10);
+
+        F3Extracter<void> ext;
+        ext.setImage(container);
+        ext.setParallel(true);
+        ext.setSecretKey("key");
+        EXPECT_EQ(msg, ext.extractMessage());
+    }
+}
+
+TEST(Jpeg, F3ParallelSubsampled) {
+    std::mt19937 gen(144);
+    const JpegImage image("test.jpg");
+    ASSERT_TRUE(subsampled(image));
+    const std::string msg = message(F3Embedder<void>::capacity(image) / 16, gen);
+
+    F3Embedder<void> emb("test.jpg");
+    emb.setParallel(true);
+    emb.setSecretKey("key");
+    emb.setMessage(msg);
+    std::vector<uint8_t> container;
+    emb.createStegoContainer(container, ".jpg");
+
+    F3Extracter<void> ext;
+    ext.setImage(container);
+    ext.setParallel(true);
+    ext.setSecretKey("key");
+    EXPECT_EQ(msg, ext.extractMessage());
+}
@@ -0,0 +1,89 @@
+// imagestego headers
+#include "imagestego/algorithms/f5.hpp"
+// c++ headers
+#include <random>
+#include <string>
+#include <vector>
+// gtest
+#include <gtest/gtest.h>
+
+using namespace imagestego;
+
+namespace {
+
+std::string message(std::size_t size, std::mt19937& gen) {
+    std::string res(size, '\0');
+    for (auto& c : res)
+        c = static_cast<char>(gen());
+    return res;
+}
+
+} // namespace
+
+TEST(Jpeg, F5RoundTrip) {
+    std::mt19937 gen(233);
+    const JpegImage image("test.jpg");
+    const std::size_t capacity = F5Embedder<void>::capacity(image);
+    ASSERT_GT(capacity, 800u);
+    for (std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(100),
+                             capacity / 8 / 4, capacity / 8 * 3 / 4}) {
+        const std::string msg = message(size, gen);
+        F5Embedder<void> emb("test.jpg");
+        emb.setSecretKey("key");
+        emb.setMessage(msg);
+        std::vector<uint8_t> container;
+        emb.createStegoContainer(container, ".jpg");
+        // matrix encoding changes fewer coefficients than half of message bits,
+        // header is embedded with k = 1 and dominates short messages
+        if (emb.rate() > 1 && size >= 100) {
+            EXPECT_LT(emb.changes(), size * 4);
+        }
+
+        F5Extracter<void> ext;
+        ext.setImage(container);
+        ext.setSecretKey("key");
+        EXPECT_EQ(msg, ext.extractMessage());
+    }
+}
+
+TEST(Jpeg, F5WrongKey) {
+    std::mt19937 gen(377);
+    const std::string msg = message(64, gen);
+    F5Embedder<void> emb("test.jpg");
+    emb.setSecretKey("key");
+    emb.setMessage(msg);
+    std::vector<uint8_t> container;
+    emb.createStegoContainer(container, ".jpg");
+
+    F5Extracter<void> ext;
+    ext.setImage(container);
+    EXPECT_THROW(ext.extractMessage(), Exception);
+    ext.setSecretKey("another key");
+    try {
+        EXPECT_NE(msg, ext.extractMessage());
+    } catch (const Exception&) {
+        // header read with another key is mostly out of range
+    }
+}
+
+TEST(Jpeg, F5BigMessage) {
+    std::mt19937 gen(610);
+    const JpegImage image("test.jpg");
+    const std::size_t capacity = F5Embedder<void>::capacity(image);
+
+    F5Embedder<void> emb("test.jpg");
+    emb.setSecretKey("key");
+    emb.setMessage(message(capacity / 8 * 5 / 4, gen));
+    std::vector<uint8_t> container;
+    EXPECT_THROW(emb.createStegoContainer(container, ".jpg"), Exception);
+    // failed attempt leaves image and keyed stream as they were
+    emb.setMessage("message");
+    emb.createStegoContainer(container, ".jpg");
+
+    F5Embedder<void> ref("test.jpg");
+    ref.setSecretKey("key");
+    ref.setMessage("message");
+    std::vector<uint8_t> expected;
+    ref.createStegoContainer(expected, ".jpg");
+    EXPECT_EQ(expected, container);
+}
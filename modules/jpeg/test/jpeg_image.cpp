@@ -0,0 +1,75 @@
+// imagestego headers
+#include "imagestego/utils/jpeg_image.hpp"
+// c++ headers
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+// gtest
+#include <gtest/gtest.h>
+
+using namespace imagestego;
+
+namespace {
+
+std::vector<uint8_t> readAll(const char* name) {
+    std::ifstream in(name, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in),
+                                std::istreambuf_iterator<char>());
+}
+
+std::vector<JCOEF> coefficients(const JpegImage& image) {
+    std::vector<JCOEF> res;
+    image.forEach([&](const JCOEF& c) -> bool {
+        res.push_back(c);
+        return true;
+    });
+    return res;
+}
+
+} // namespace
+
+TEST(Jpeg, JpegImageBuffer) {
+    const std::vector<uint8_t> src = readAll("test.jpg");
+    ASSERT_FALSE(src.empty());
+    const JpegImage file("test.jpg");
+    JpegImage image(src);
+    EXPECT_EQ(file.rows, image.rows);
+    EXPECT_EQ(file.cols, image.cols);
+    EXPECT_EQ(coefficients(file), coefficients(image));
+
+    std::vector<uint8_t> dst;
+    image.writeTo(dst);
+    ASSERT_FALSE(dst.empty());
+    const JpegImage copy(dst);
+    EXPECT_EQ(coefficients(file), coefficients(copy));
+}
+
+TEST(Jpeg, JpegImageCorrupted) {
+    std::vector<uint8_t> src = readAll("test.jpg");
+    ASSERT_GT(src.size(), 4u);
+    // no start of image marker
+    std::vector<uint8_t> garbage(src.begin() + 2, src.end());
+    try {
+        JpegImage image(garbage);
+        FAIL() << "corrupted image is opened";
+    } catch (const Exception& e) {
+        EXPECT_STREQ("Image is corrupted", e.what());
+    }
+    // unsupported sample precision in frame header
+    const uint8_t sof[] = {0xff, 0xc2};
+    auto it = std::search(src.begin(), src.end(), sof, sof + 2);
+    ASSERT_NE(src.end(), it);
+    *(it + 4) = 3;
+    JpegImage image;
+    try {
+        image.open(src);
+        FAIL() << "corrupted image is opened";
+    } catch (const Exception& e) {
+        EXPECT_STREQ("Image is corrupted", e.what());
+    }
+    // image stays usable after failure
+    EXPECT_TRUE(image.isEmpty());
+    image.open(readAll("test.jpg"));
+    EXPECT_FALSE(image.isEmpty());
+}
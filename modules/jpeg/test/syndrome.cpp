@@ -0,0 +1,79 @@
+// imagestego headers
+#include "imagestego/core/permutation.hpp"
+#include "syndrome.hpp"
+// c++ headers
+#include <cstdio>
+#include <random>
+#include <vector>
+// libjpeg, for JCOEF only
+#include <jpeglib.h>
+// gtest
+#include <gtest/gtest.h>
+
+using namespace imagestego;
+
+namespace {
+
+std::vector<JCOEF> coefficients(std::size_t n, std::mt19937& gen) {
+    // mostly small values and zeros, as AC coefficients are
+    std::vector<JCOEF> res(n);
+    for (auto& c : res)
+        c = static_cast<JCOEF>(static_cast<int>(gen() % 11) - 5);
+    return res;
+}
+
+} // namespace
+
+TEST(Jpeg, SyndromeRoundTrip) {
+    std::mt19937 gen(42);
+    for (int width = 1; width <= 9; ++width) {
+        std::vector<JCOEF> coeffs = coefficients(20000, gen);
+        const Permutation perm(coeffs.size(), 1337u);
+        auto at = [&](std::size_t i) -> JCOEF& { return coeffs[perm[i]]; };
+        auto writer = syndromeWriter<JCOEF>(at, coeffs.size());
+        std::vector<uint32_t> values;
+        for (;;) {
+            const uint32_t value = gen() & ((1u << width) - 1);
+            if (!writer.write(width, value))
+                break;
+            values.push_back(value);
+        }
+        ASSERT_FALSE(values.empty());
+        // every group costs at most one change besides shrinkage
+        EXPECT_LE(writer.changes(), 2 * values.size());
+
+        auto reader = syndromeReader<JCOEF>(
+            [&](std::size_t i) -> JCOEF { return coeffs[perm[i]]; }, coeffs.size());
+        for (uint32_t value : values)
+            ASSERT_EQ(value, reader.read(width));
+    }
+}
+
+TEST(Jpeg, SyndromeSingleChange) {
+    // without +-1 coefficients nothing shrinks, so each group changes at most once
+    JCOEF coeffs[] = {2, -3, 0, 4, -2, 0, 0, 5, 3, -4};
+    for (uint32_t value = 0; value != 8; ++value) {
+        std::vector<JCOEF> copy(coeffs, coeffs + 10);
+        auto writer = syndromeWriter<JCOEF>(
+            [&](std::size_t i) -> JCOEF& { return copy[i]; }, copy.size());
+        ASSERT_TRUE(writer.write(3, value));
+        int changed = 0;
+        for (std::size_t i = 0; i != copy.size(); ++i)
+            changed += copy[i] != coeffs[i];
+        EXPECT_LE(changed, 1);
+        EXPECT_EQ(writer.changes(), static_cast<std::size_t>(changed));
+        auto reader = syndromeReader<JCOEF>(
+            [&](std::size_t i) -> JCOEF { return copy[i]; }, copy.size());
+        EXPECT_EQ(value, reader.read(3));
+    }
+}
+
+TEST(Jpeg, SyndromeExhausted) {
+    std::vector<JCOEF> coeffs = {1, 0, -2, 0};
+    auto writer = syndromeWriter<JCOEF>(
+        [&](std::size_t i) -> JCOEF& { return coeffs[i]; }, coeffs.size());
+    EXPECT_FALSE(writer.write(2, 3));
+    auto reader = syndromeReader<JCOEF>(
+        [&](std::size_t i) -> JCOEF { return coeffs[i]; }, coeffs.size());
+    EXPECT_THROW(reader.read(2), imagestego::Exception);
+}
@@ -29,10 +29,14 @@
 #include "imagestego/core.hpp"
 #include "imagestego/core/bitarray.hpp"
 #include "imagestego/core/interfaces.hpp"
+// opencv headers
+#include <opencv2/core.hpp>
 // c++ headers
+#include <iosfwd>
 #include <random>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace imagestego {
 
@@ -68,6 +72,33 @@ public:
      */
     void setImage(const std::string& src) override;
 
+    /**
+     * Setter for source image.
+     *
+     * @param buf Encoded image.
+     */
+    void setImage(const std::vector<uint8_t>& buf) override;
+
+    /**
+     * Setter for source image.
+     *
+     * Image is copied, so the source stays untouched.
+     *
+     * @param image Image of type CV_8UC3.
+     * @throws imagestego::Exception if image has another type.
+     */
+    void setImage(const cv::Mat& image);
+
+    /**
+     * Setter for source image.
+     *
+     * Image data is shared, so embedding is performed in-place.
+     *
+     * @param image Image of type CV_8UC3.
+     * @throws imagestego::Exception if image has another type.
+     */
+    void setImage(cv::Mat& image);
+
     /**
      * Setter for message.
      *
@@ -75,6 +106,17 @@ public:
      */
     void setMessage(const std::string& msg) override;
 
+    /**
+     * Setter for message read from stream.
+     *
+     * Message is read by chunks during embedding, so stream must stay valid until
+     * createStegoContainer() returns. If encoder implements StreamEncoder, chunks are
+     * encoded and embedded one by one, otherwise the whole message is encoded at once.
+     *
+     * @param stream Message stream.
+     */
+    void setMessage(std::istream& stream);
+
     /**
      * Setter for secret key.
      *
@@ -89,6 +131,29 @@ public:
      */
     void createStegoContainer(const std::string& dst) override;
 
+    /**
+     * Performs embedding.
+     *
+     * @param dst Buffer for encoded image.
+     * @param ext Extension defining image format, e.g. ".png".
+     */
+    void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) override;
+
+    /**
+     * Performs embedding.
+     *
+     * @param dst Image with embedded message, shares data with source image.
+     */
+    void createStegoContainer(cv::Mat& dst);
+
+    /**
+     * Computes maximal message length for given image.
+     *
+     * @param size Image size.
+     * @return Number of bits available for encoded message.
+     */
+    static std::size_t capacity(const cv::Size& size) noexcept;
+
 private:
     impl::LsbEmbedder* _embedder;
 }; // class LsbEmbedder
@@ -117,6 +182,23 @@ public:
      */
     void setImage(const std::string& dst) override;
 
+    /**
+     * Setter for stego container.
+     *
+     * @param buf Encoded image with stego message.
+     */
+    void setImage(const std::vector<uint8_t>& buf) override;
+
+    /**
+     * Setter for stego container.
+     *
+     * Image data is shared, not copied.
+     *
+     * @param image Image of type CV_8UC3 with stego message.
+     * @throws imagestego::Exception if image has another type.
+     */
+    void setImage(const cv::Mat& image);
+
     /**
      * Sets secret key.
      *
@@ -131,6 +213,15 @@ public:
      */
     std::string extractMessage() override;
 
+    /**
+     * Extracts message from image into stream.
+     *
+     * Message is extracted by chunks unless decoder doesn't implement StreamDecoder.
+     *
+     * @param stream Destination stream.
+     */
+    void extractMessage(std::ostream& stream);
+
 private:
     impl::LsbExtracter* _extracter;
 }; // class LsbExtracter
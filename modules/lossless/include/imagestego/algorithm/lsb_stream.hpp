@@ -0,0 +1,172 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_LSB_STREAM_HPP_INCLUDED__
+#define __IMAGESTEGO_LSB_STREAM_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core.hpp"
+#include "imagestego/core/interfaces.hpp"
+// opencv headers
+#include <opencv2/core.hpp>
+// c++ headers
+#include <string>
+
+namespace imagestego {
+
+namespace impl {
+
+class LsbStripEmbedder;
+
+class LsbStripExtracter;
+
+} // namespace impl
+
+/**
+ * @brief LSB embedding over horizontal strips of an image.
+ *
+ * Produces the same container as LsbEmbedder, but never needs the whole image in
+ * memory: strips may be decoded, processed and written one after another. Every
+ * pixel of a strip is mapped back to its index in the route, so no route points
+ * are kept and memory doesn't depend on the size of the image.
+ */
+class IMAGESTEGO_EXPORTS LsbStripEmbedder {
+public:
+    /**
+     * Constructs embedder with given encoder.
+     *
+     * @param encoder Encoder which will process data.
+     */
+    explicit LsbStripEmbedder(Encoder* encoder = nullptr);
+
+    /**
+     * LsbStripEmbedder destructor.
+     */
+    virtual ~LsbStripEmbedder() noexcept;
+
+    /**
+     * Setter for size of the whole image.
+     *
+     * @param size Image size.
+     */
+    void setImageSize(const cv::Size& size);
+
+    /**
+     * Setter for message.
+     *
+     * @param msg Message string.
+     */
+    void setMessage(const std::string& msg);
+
+    /**
+     * Setter for secret key.
+     *
+     * @param key Secret key string.
+     */
+    void setSecretKey(const std::string& key);
+
+    /**
+     * Embeds part of the message falling into given strip.
+     *
+     * Strips may come in any order, each one should be passed exactly once.
+     *
+     * @param strip Rows [y, y + strip.rows) of CV_8UC3 image, modified in-place.
+     * @param y Index of the first row of strip.
+     * @throws imagestego::Exception if key is not set, message doesn't fit into
+     * image or strip doesn't match image size.
+     */
+    void embedStrip(cv::Mat& strip, int y);
+
+private:
+    impl::LsbStripEmbedder* _embedder;
+}; // class LsbStripEmbedder
+
+/**
+ * @brief LSB extracting over horizontal strips of an image.
+ *
+ * Counterpart of LsbStripEmbedder, reads containers of LsbEmbedder as well.
+ * Message size is stored at the beginning of the route, so the points of the
+ * message are known only once the size has been read. Apart from the message
+ * itself only one bit per message bit is kept. Points falling into strips
+ * passed before the size is known are missed; if complete() returns false
+ * after the last strip, the image should be passed once more.
+ */
+class IMAGESTEGO_EXPORTS LsbStripExtracter {
+public:
+    /**
+     * Constructs extracter with given decoder.
+     *
+     * @param decoder Decoder of extracted data.
+     */
+    explicit LsbStripExtracter(Decoder* decoder = nullptr);
+
+    /**
+     * LsbStripExtracter destructor.
+     */
+    virtual ~LsbStripExtracter() noexcept;
+
+    /**
+     * Setter for size of the whole image.
+     *
+     * @param size Image size.
+     */
+    void setImageSize(const cv::Size& size);
+
+    /**
+     * Sets secret key.
+     *
+     * @param key Secret key.
+     */
+    void setSecretKey(const std::string& key);
+
+    /**
+     * Reads bits falling into given strip.
+     *
+     * @param strip Rows [y, y + strip.rows) of CV_8UC3 image.
+     * @param y Index of the first row of strip.
+     * @throws imagestego::Exception if key is not set, stored size doesn't fit
+     * into image or strip doesn't match image size.
+     */
+    void extractStrip(const cv::Mat& strip, int y);
+
+    /**
+     * Checks whether all bits of the message have been read.
+     */
+    bool complete() const noexcept;
+
+    /**
+     * Assembles extracted message.
+     *
+     * @return Extracted message.
+     * @throws imagestego::Exception if message is not complete.
+     */
+    std::string extractMessage();
+
+private:
+    impl::LsbStripExtracter* _extracter;
+}; // class LsbStripExtracter
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_LSB_STREAM_HPP_INCLUDED__ */
@@ -30,14 +30,21 @@
 // c++ headers
 #include <algorithm>
 #include <functional>
-#ifdef IMAGESTEG0_DEBUG
+#ifdef IMAGESTEGO_DEBUG
 #include <iostream>
 #endif
-#include <random>
 #include <utility>
+#include <vector>
 
 namespace imagestego {
 
+/**
+ * @brief AVL tree stored in contiguous arena.
+ *
+ * Nodes live in one vector and refer to each other by index, so insertion doesn't
+ * allocate once reserve() has been called, and clear() or destruction releases all
+ * nodes at once.
+ */
 template<typename T, class Comp = std::less<T>>
 class AvlTree {
     class Iterator;
@@ -53,155 +60,115 @@ public:
         for (auto it = begin; it != end; ++it)
             insert(*it);
     }
-    AvlTree(const AvlTree<T, Comp>& other) : _size(other._size) {
-        copy(other.root, root);
-    }
-    AvlTree(AvlTree<T, Comp>&& other) noexcept : root(other.root), _size(other._size) {
-        other.root = nullptr;
-    }
-    virtual ~AvlTree() noexcept {
-        if (!isEmpty())
-            delete root;
-    }
-    AvlTree<T, Comp>& operator=(AvlTree<T, Comp>&& other) noexcept {
-        root = other.root;
-        _size = other._size;
-        other.root = nullptr;
-        return *this;
-    }
-    AvlTree<T, Comp>& operator=(const AvlTree<T, Comp>& other) {
-        if (this != &other)
-            copy(other.root, root);
-        return *this;
+    void insert(const T& data) { root = insertImpl(root, data); }
+    inline bool isEmpty() const noexcept { return root == npos; }
+    bool search(const T& data) const noexcept {
+        index_type node = root;
+        while (node != npos) {
+            const T& value = nodes[node].data;
+            if (data == value)
+                return true;
+            node = cmp(data, value) ? nodes[node].leftChild : nodes[node].rightChild;
+        }
+        return false;
     }
-    void insert(const T& data) noexcept { root = insertImpl(root, data); }
-    inline bool isEmpty() const noexcept { return root == nullptr; }
-    bool search(const T& data) const noexcept { return searchImpl(root, data); }
+    /**
+     * Preallocates arena for n nodes.
+     */
+    inline void reserve(std::size_t n) { nodes.reserve(n); }
     inline void clear() noexcept {
-        if (!isEmpty())
-            delete root;
-        root = nullptr;
-        _size = 0;
+        nodes.clear();
+        root = npos;
     }
-    inline std::size_t size() const noexcept { return _size; }
+    inline std::size_t size() const noexcept { return nodes.size(); }
 #ifdef IMAGESTEGO_DEBUG
     void printDfs() const noexcept { // for debugging purposes
-        if (!isEmpty())
-            printDfsImpl(root);
+        for (auto it = begin(); it != end(); ++it)
+            std::cout << *it << std::endl;
     }
 #endif
-    const_iterator begin() noexcept { return Iterator(this, root, false); }
-    const_iterator end() noexcept { return Iterator(this, root, true); }
+    const_iterator begin() const noexcept { return Iterator(this, root); }
+    const_iterator end() const noexcept { return Iterator(this, npos); }
 
 private:
-    class TreeNode {
-        friend class AvlTree<T, Comp>;
+    typedef std::size_t index_type;
+    static constexpr index_type npos = static_cast<index_type>(-1);
 
-    private:
-        T _data = T();
-        int _height = 1;
-        TreeNode* leftChild = nullptr;
-        TreeNode* rightChild = nullptr;
-        TreeNode* parent = nullptr;
-        explicit TreeNode(const T& data) noexcept : _data(data) {}
+    struct TreeNode {
+        T data;
+        int height;
+        index_type leftChild;
+        index_type rightChild;
+        index_type parent;
+    }; // struct TreeNode
 
-    public:
-        virtual ~TreeNode() noexcept {
-            if (leftChild)
-                delete leftChild;
-            if (rightChild)
-                delete rightChild;
-        }
-        static inline int height(TreeNode* node) { return (node) ? node->_height : 0; }
-        inline const T& data() const noexcept { return _data; }
-        inline int balanceFactor() { return height(rightChild) - height(leftChild); }
-        inline int height() {
-            _height = std::max(height(rightChild), height(leftChild)) + 1;
-            return _height;
-        }
-    }; // class TreeNode
-    static TreeNode* rotateRight(TreeNode* node) {
-        TreeNode* tmp = node->leftChild;
-        TreeNode* T2 = tmp->rightChild;
-        node->leftChild = tmp->rightChild;
-        tmp->rightChild = node;
-        if (T2)
-            T2->parent = node;
-        tmp->parent = node->parent;
-        node->parent = tmp;
-        node->height();
-        tmp->height();
+    inline int height(index_type node) const noexcept {
+        return (node != npos) ? nodes[node].height : 0;
+    }
+    inline int balanceFactor(index_type node) const noexcept {
+        return height(nodes[node].rightChild) - height(nodes[node].leftChild);
+    }
+    inline void updateHeight(index_type node) noexcept {
+        nodes[node].height =
+            std::max(height(nodes[node].rightChild), height(nodes[node].leftChild)) + 1;
+    }
+    index_type rotateRight(index_type node) noexcept {
+        const index_type tmp = nodes[node].leftChild;
+        const index_type T2 = nodes[tmp].rightChild;
+        nodes[node].leftChild = T2;
+        nodes[tmp].rightChild = node;
+        if (T2 != npos)
+            nodes[T2].parent = node;
+        nodes[tmp].parent = nodes[node].parent;
+        nodes[node].parent = tmp;
+        updateHeight(node);
+        updateHeight(tmp);
         return tmp;
     }
-    static TreeNode* rotateLeft(TreeNode* node) {
-        TreeNode* tmp = node->rightChild;
-        TreeNode* T2 = tmp->leftChild;
-        node->rightChild = tmp->leftChild;
-        tmp->leftChild = node;
-        if (T2)
-            T2->parent = node;
-        tmp->parent = node->parent;
-        node->parent = tmp;
-        node->height();
-        tmp->height();
+    index_type rotateLeft(index_type node) noexcept {
+        const index_type tmp = nodes[node].rightChild;
+        const index_type T2 = nodes[tmp].leftChild;
+        nodes[node].rightChild = T2;
+        nodes[tmp].leftChild = node;
+        if (T2 != npos)
+            nodes[T2].parent = node;
+        nodes[tmp].parent = nodes[node].parent;
+        nodes[node].parent = tmp;
+        updateHeight(node);
+        updateHeight(tmp);
         return tmp;
     }
-    static TreeNode* balance(TreeNode* node) {
-        node->height();
-        if (node->balanceFactor() == 2) {
-            if (node->rightChild->balanceFactor() < 0)
-                node->rightChild = rotateRight(node->rightChild);
+    index_type balance(index_type node) noexcept {
+        updateHeight(node);
+        if (balanceFactor(node) == 2) {
+            if (balanceFactor(nodes[node].rightChild) < 0)
+                nodes[node].rightChild = rotateRight(nodes[node].rightChild);
             return rotateLeft(node);
         }
-        if (node->balanceFactor() == -2) {
-            if (node->leftChild->balanceFactor() > 0)
-                node->leftChild = rotateLeft(node->leftChild);
+        if (balanceFactor(node) == -2) {
+            if (balanceFactor(nodes[node].leftChild) > 0)
+                nodes[node].leftChild = rotateLeft(nodes[node].leftChild);
             return rotateRight(node);
         }
         return node;
     }
-    TreeNode* insertImpl(TreeNode* node, const T& data) {
-        if (!node) {
-            ++_size;
-            return new TreeNode(data);
+    index_type insertImpl(index_type node, const T& data) {
+        if (node == npos) {
+            nodes.push_back(TreeNode{data, 1, npos, npos, npos});
+            return nodes.size() - 1;
         }
-        if (cmp(data, node->data())) {
-            node->leftChild = insertImpl(node->leftChild, data);
-            node->leftChild->parent = node;
-        } else if (data != node->data()) {
-            node->rightChild = insertImpl(node->rightChild, data);
-            node->rightChild->parent = node;
+        // arena may grow, so references to nodes aren't kept across insertion
+        if (cmp(data, nodes[node].data)) {
+            const index_type child = insertImpl(nodes[node].leftChild, data);
+            nodes[node].leftChild = child;
+            nodes[child].parent = node;
+        } else if (data != nodes[node].data) {
+            const index_type child = insertImpl(nodes[node].rightChild, data);
+            nodes[node].rightChild = child;
+            nodes[child].parent = node;
         }
         return balance(node);
     }
-    bool searchImpl(const TreeNode* node, const T& data) const {
-        if (!node)
-            return false;
-        if (data == node->data())
-            return true;
-        if (cmp(data, node->data()))
-            return searchImpl(node->leftChild, data);
-        else
-            return searchImpl(node->rightChild, data);
-    }
-#ifdef IMAGESTEG0_DEBUG
-    static void printDfsImpl(const TreeNode* node) {
-        std::cout << node->data() << std::endl;
-        if (node->leftChild)
-            printDfsImpl(node->leftChild);
-        if (node->rightChild)
-            printDfsImpl(node->rightChild);
-    }
-#endif
-    static void copy(TreeNode* from, TreeNode* to) {
-        if (from) {
-            to = new TreeNode(from->data());
-            copy(from->leftChild, to->leftChild);
-            copy(from->rightChild, to->rightChild);
-        } else {
-            to = nullptr;
-        }
-    }
     // Base class representing tree iterator
     // Operator ++ stands for going to the next
     // node in DFS algorithm
@@ -209,48 +176,34 @@ private:
         friend class AvlTree<T, Comp>;
 
     private:
-        TreeNode* node;
-        AvlTree<T, Comp>* owner;
-        bool isEnd = false;
-        explicit Iterator(AvlTree<T, Comp>* owner, TreeNode* node, bool flag) noexcept
-            : node(node), owner(owner), isEnd(flag) {}
+        const AvlTree<T, Comp>* owner;
+        index_type node;
+        explicit Iterator(const AvlTree<T, Comp>* owner, index_type node) noexcept
+            : owner(owner), node(node) {}
 
     public:
         typedef T value_type;
-        inline T operator*() { return node->data(); }
-        inline const T* operator->() { return &node->data(); }
+        inline T operator*() { return owner->nodes[node].data; }
+        inline const T* operator->() { return &owner->nodes[node].data; }
         Iterator& operator++() {
-            if (node->leftChild) {
-                node = node->leftChild;
+            const auto& nodes = owner->nodes;
+            if (nodes[node].leftChild != npos) {
+                node = nodes[node].leftChild;
                 return *this;
             }
-            if (node->rightChild) {
-                node = node->rightChild;
+            if (nodes[node].rightChild != npos) {
+                node = nodes[node].rightChild;
                 return *this;
             }
-            if (node != owner->root) {
-                TreeNode* cameFrom;
-                do {
-                    cameFrom = node;
-                    node = node->parent;
-                } while (node->rightChild == cameFrom && node != owner->root);
-                if (cameFrom == node->leftChild) {
-                    if (node->rightChild) {
-                        node = node->rightChild;
-                        return *this;
-                    } else if (node->parent) {
-                        do {
-                            cameFrom = node;
-                            node = node->parent;
-                        } while (node->rightChild == cameFrom && node != owner->root);
-                        if (node != owner->root || cameFrom != node->rightChild) {
-                            node = node->rightChild;
-                            return *this;
-                        }
-                    }
+            // go up until there is unvisited right subtree
+            for (index_type parent = nodes[node].parent; parent != npos;
+                 node = parent, parent = nodes[node].parent) {
+                if (nodes[parent].leftChild == node && nodes[parent].rightChild != npos) {
+                    node = nodes[parent].rightChild;
+                    return *this;
                 }
             }
-            isEnd = true;
+            node = npos;
             return *this;
         }
         Iterator operator++(int) {
@@ -259,17 +212,20 @@ private:
             return tmp;
         }
         bool operator==(const Iterator& other) const noexcept {
-            return node == other.node && isEnd == other.isEnd;
+            return node == other.node;
         }
         bool operator!=(const Iterator& other) const noexcept {
             return !(*this == other);
         }
     }; // struct Iterator
-    TreeNode* root = nullptr;
-    std::size_t _size = 0; // for O(1) size()
+    std::vector<TreeNode> nodes;
+    index_type root = npos;
     Comp cmp = Comp();
 }; // class AvlTree
 
+template<typename T, class Comp>
+constexpr typename AvlTree<T, Comp>::index_type AvlTree<T, Comp>::npos;
+
 template<class T1, class T2, class Pair = std::pair<T1, T2>>
 struct PairComparator final {
     constexpr bool operator()(const Pair& lhs, const Pair& rhs) const noexcept {
@@ -28,11 +28,24 @@
 // opencv headers
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
+// c++ headers
+#include <algorithm>
+#include <istream>
+#include <ostream>
 
 namespace imagestego {
 
 namespace impl {
 
+namespace {
+
+void checkImage(const cv::Mat& image) {
+    if (image.type() != CV_8UC3)
+        throw Exception(Exception::Codes::InvalidImageType);
+}
+
+} // namespace
+
 class LsbEmbedder final {
 public:
     explicit LsbEmbedder(Encoder* encoder = nullptr) noexcept
@@ -42,7 +55,19 @@ public:
             delete _encoder;
     }
     void setImage(const std::string& src) { _image = cv::imread(src); }
+    void setImage(const std::vector<uint8_t>& buf) {
+        _image = cv::imdecode(buf, cv::IMREAD_COLOR);
+    }
+    void setImage(const cv::Mat& image) {
+        checkImage(image);
+        _image = image.clone();
+    }
+    void setImage(cv::Mat& image) {
+        checkImage(image);
+        _image = image;
+    }
     void setMessage(const std::string& msg) {
+        _stream = nullptr;
         if (_encoder) {
             _encoder->setMessage(msg);
             _msg = _encoder->getEncodedMessage();
@@ -50,68 +75,110 @@ public:
             _msg = imagestego::BitArray::fromByteString(msg);
         }
     }
+    void setMessage(std::istream& stream) {
+        _stream = &stream;
+        _msg.clear();
+    }
     void setSecretKey(const std::string& key) {
         _key = imagestego::BitArray::fromByteString(key);
         _gen.seed(hash(key));
     }
     void createStegoContainer(const std::string& dst) {
+        embed();
+        cv::imwrite(dst, _image);
+    }
+    void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) {
+        embed();
+        cv::imencode(ext, _image, dst);
+    }
+    void createStegoContainer(cv::Mat& dst) {
+        embed();
+        dst = _image;
+    }
+
+private:
+    /** number of message bytes read from stream at once */
+    static constexpr std::size_t chunkSize = 1 << 16;
+    void embed() {
         if (_key.empty())
             throw Exception(Exception::Codes::NoKeyFound);
-        BitArray sz = BitArray::fromInt(_msg.size());
-        std::size_t idx = 0, i = 0;
+        if (_stream) {
+            embedStream();
+            return;
+        }
+        const uint64_t sz = _msg.size();
         Route r(std::make_pair(_image.cols, _image.rows), _gen);
-        r.create(32);
-        for (auto it = r.begin(); it != r.end(); ++it) {
-            auto& pix = _image.at<cv::Vec3b>(it->second, it->first);
-            bool b = (pix.val[0] & 1u) != 0;
-            if (b != _key[idx]) {
-                if (sz[i])
-                    pix.val[1] |= 1u;
-                else
-                    pix.val[1] &= ~1u;
-            } else {
-                if (sz[i])
-                    pix.val[2] |= 1u;
-                else
-                    pix.val[2] &= ~1u;
-            }
-            idx = (idx + 1) % _key.size();
-            ++i;
+        // first 32 points hold message size, the rest hold message itself
+        r.create(32 + _msg.size());
+        // writes go in memory order, so the image is traversed only once
+        for (const auto& point : r.sorted(0, r.size())) {
+            const std::size_t i = point.second;
+            put(point.first, i, (i < 32) ? ((sz >> (31 - i)) & 1u) != 0 : _msg[i - 32]);
         }
-
-        Route r1(r.begin(), r.end(), _gen);
-        r1.setMapSize(std::make_pair(_image.cols, _image.rows));
-        r1.create(32 + _msg.size());
-        i = 0;
-        for (auto it = r1.begin(); it != r1.end(); ++it) {
-            if (r.search(*it))
-                continue;
-            auto& pixel = _image.at<cv::Vec3b>(it->second, it->first);
-            bool b = (pixel.val[0] & 1) != 0;
-            if (b != _key[idx]) {
-                if (_msg[i])
-                    pixel.val[1] |= 1;
-                else
-                    pixel.val[1] &= ~1u;
+    }
+    /**
+     * Embeds message chunk by chunk as it is read and encoded, size goes last since
+     * it is known only at the end. Image is left partially modified if message
+     * doesn't fit.
+     */
+    void embedStream() {
+        Route r(std::make_pair(_image.cols, _image.rows), _gen);
+        StreamEncoder* encoder = dynamic_cast<StreamEncoder*>(_encoder);
+        // encoders without streaming support need the whole message
+        std::string buffered;
+        std::vector<char> chunk(chunkSize);
+        uint64_t sz = 0;
+        auto flush = [&](const imagestego::BitArray& bits) {
+            r.create(32 + sz + bits.size());
+            for (const auto& point : r.sorted(32 + sz, r.size()))
+                put(point.first, point.second, bits[point.second - 32 - sz]);
+            sz += bits.size();
+        };
+        do {
+            _stream->read(chunk.data(), chunk.size());
+            const std::size_t n = static_cast<std::size_t>(_stream->gcount());
+            if (encoder) {
+                encoder->write(chunk.data(), n);
+                flush(encoder->read());
+            } else if (_encoder) {
+                buffered.append(chunk.data(), n);
             } else {
-                if (_msg[i])
-                    pixel.val[2] |= 1u;
-                else
-                    pixel.val[2] &= ~1u;
+                imagestego::BitArray bits;
+                bits.appendBytes(reinterpret_cast<const uint8_t*>(chunk.data()), n);
+                flush(bits);
             }
-            idx = (idx + 1) % _key.size();
-            ++i;
+        } while (*_stream);
+        if (encoder) {
+            encoder->finish();
+            flush(encoder->read());
+        } else if (_encoder) {
+            _encoder->setMessage(buffered);
+            flush(_encoder->getEncodedMessage());
         }
-        cv::imwrite(dst, _image);
+        for (std::size_t i = 0; i != 32; ++i)
+            put(r.pixel(i), i, ((sz >> (31 - i)) & 1u) != 0);
+    }
+    /** writes i-th bit of route into given pixel */
+    inline void put(uint64_t idx, std::size_t i, bool bit) {
+        const uint64_t cols = _image.cols;
+        auto& pixel = _image.at<cv::Vec3b>(static_cast<int>(idx / cols),
+                                           static_cast<int>(idx % cols));
+        bool b = (pixel.val[0] & 1u) != 0;
+        const int channel = (b != _key[i % _key.size()]) ? 1 : 2;
+        if (bit)
+            pixel.val[channel] |= 1u;
+        else
+            pixel.val[channel] &= ~1u;
     }
 
-private:
     Encoder* _encoder = nullptr;
     /** PRNG */
     std::mt19937 _gen;
     /** image */
     cv::Mat _image;
     imagestego::BitArray _key, _msg;
+    /** message source, if set message is read during embedding */
+    std::istream* _stream = nullptr;
 }; // class LsbEmbedder
 
 class LsbExtracter final {
@@ -123,6 +190,13 @@ public:
             delete _decoder;
     }
     void setImage(const std::string& src) { _image = cv::imread(src); }
+    void setImage(const std::vector<uint8_t>& buf) {
+        _image = cv::imdecode(buf, cv::IMREAD_COLOR);
+    }
+    void setImage(const cv::Mat& image) {
+        checkImage(image);
+        _image = image;
+    }
     void setSecretKey(const std::string& key) {
         _key = imagestego::BitArray::fromByteString(key);
         _gen.seed(hash(key));
@@ -130,35 +204,9 @@ public:
     std::string extractMessage() {
         if (_key.empty())
             throw Exception(Exception::Codes::NoKeyFound);
-        imagestego::BitArray sz;
-        std::size_t idx = 0;
         Route r(std::make_pair(_image.cols, _image.rows), _gen);
-        r.create(32);
-        for (auto it = r.begin(); it != r.end(); ++it) {
-            auto pix = _image.at<cv::Vec3b>(it->second, it->first);
-            bool b = (pix.val[0] & 1u) != 0;
-            if (_key[idx] != b)
-                sz.pushBack((pix.val[1] & 1u) != 0);
-            else
-                sz.pushBack((pix.val[2] & 1u) != 0);
-            idx = (idx + 1) % _key.size();
-        }
-        auto size = sz.toInt();
-        imagestego::BitArray msg;
-        Route r1(r.begin(), r.end(), _gen);
-        r1.setMapSize(std::make_pair(_image.cols, _image.rows));
-        r1.create(32 + size);
-        for (auto it = r1.begin(); it != r1.end(); ++it) {
-            if (r.search(*it))
-                continue;
-            auto pixel = _image.at<cv::Vec3b>(it->second, it->first);
-            bool b = (pixel.val[0] & 1u) != 0;
-            if (_key[idx] != b)
-                msg.pushBack((pixel.val[1] & 1u) != 0);
-            else
-                msg.pushBack((pixel.val[2] & 1u) != 0);
-            idx = (idx + 1) % _key.size();
-        }
+        r.create(32 + readSize(r));
+        const imagestego::BitArray msg = gather(r, 32, r.size());
         if (_decoder) {
             _decoder->setMessage(msg);
             return _decoder->getDecodedMessage();
@@ -166,8 +214,81 @@ public:
             return msg.toByteString();
         }
     }
+    void extractMessage(std::ostream& stream) {
+        StreamDecoder* decoder = dynamic_cast<StreamDecoder*>(_decoder);
+        if (_decoder && !decoder) {
+            // decoders without streaming support need the whole message
+            const std::string msg = extractMessage();
+            stream.write(msg.data(), msg.size());
+            return;
+        }
+        if (_key.empty())
+            throw Exception(Exception::Codes::NoKeyFound);
+        Route r(std::make_pair(_image.cols, _image.rows), _gen);
+        r.create(32 + readSize(r));
+        for (std::size_t first = 32; first < r.size(); first += chunkBits) {
+            const imagestego::BitArray bits =
+                gather(r, first, std::min(first + chunkBits, r.size()));
+            std::string str;
+            if (decoder) {
+                decoder->write(bits);
+                str = decoder->read();
+            } else {
+                str = bits.toByteString();
+            }
+            stream.write(str.data(), str.size());
+        }
+        if (decoder) {
+            decoder->finish();
+            const std::string str = decoder->read();
+            stream.write(str.data(), str.size());
+        }
+    }
 
 private:
+    /** number of message bits extracted at once, multiple of 8 */
+    static constexpr std::size_t chunkBits = 1 << 19;
+    /** reads message size from the first 32 points */
+    std::size_t readSize(Route& r) const {
+        const imagestego::BitArray& key = _key;
+        std::size_t idx = 0, size = 0;
+        r.create(32);
+        for (auto it = r.begin(); it != r.end(); ++it) {
+            auto pix = _image.at<cv::Vec3b>(it->second, it->first);
+            bool b = (pix.val[0] & 1u) != 0;
+            const int channel = (key[idx] != b) ? 1 : 2;
+            size = (size << 1) | (pix.val[channel] & 1u);
+            idx = (idx + 1) % key.size();
+        }
+        return size;
+    }
+    /** gathers bits of points [first, last) in memory order and reorders them */
+    imagestego::BitArray gather(const Route& r, std::size_t first, std::size_t last) const {
+        const imagestego::BitArray& key = _key;
+        const uint64_t cols = _image.cols;
+        std::vector<bool> bits(last - first);
+        for (const auto& point : r.sorted(first, last)) {
+            const std::size_t i = point.second;
+            const auto& pixel =
+                _image.at<cv::Vec3b>(static_cast<int>(point.first / cols),
+                                     static_cast<int>(point.first % cols));
+            bool b = (pixel.val[0] & 1u) != 0;
+            const int channel = (key[i % key.size()] != b) ? 1 : 2;
+            bits[i - first] = (pixel.val[channel] & 1u) != 0;
+        }
+        imagestego::BitArray msg;
+        uint64_t word = 0;
+        std::size_t n = 0;
+        for (std::size_t i = 0; i != bits.size(); ++i) {
+            word = (word << 1) | (bits[i] ? 1u : 0u);
+            if (++n == 64) {
+                msg.appendBits(word, 64);
+                n = 0;
+            }
+        }
+        msg.appendBits(word, n);
+        return msg;
+    }
     Decoder* _decoder;
     std::mt19937 _gen;
     cv::Mat _image;
@@ -187,14 +308,35 @@ LsbEmbedder::~LsbEmbedder() noexcept {
 
 void LsbEmbedder::setImage(const std::string& src) { _embedder->setImage(src); }
 
+void LsbEmbedder::setImage(const std::vector<uint8_t>& buf) { _embedder->setImage(buf); }
+
+void LsbEmbedder::setImage(const cv::Mat& image) { _embedder->setImage(image); }
+
+void LsbEmbedder::setImage(cv::Mat& image) { _embedder->setImage(image); }
+
 void LsbEmbedder::setMessage(const std::string& msg) { _embedder->setMessage(msg); }
 
+void LsbEmbedder::setMessage(std::istream& stream) { _embedder->setMessage(stream); }
+
 void LsbEmbedder::setSecretKey(const std::string& key) { _embedder->setSecretKey(key); }
 
 void LsbEmbedder::createStegoContainer(const std::string& dst) {
     _embedder->createStegoContainer(dst);
 }
 
+void LsbEmbedder::createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) {
+    _embedder->createStegoContainer(dst, ext);
+}
+
+void LsbEmbedder::createStegoContainer(cv::Mat& dst) { _embedder->createStegoContainer(dst); }
+
+std::size_t LsbEmbedder::capacity(const cv::Size& size) noexcept {
+    // every pixel holds one bit, the first 32 ones hold message size
+    const std::size_t pixels = static_cast<std::size_t>(std::max(size.width, 0)) *
+                               static_cast<std::size_t>(std::max(size.height, 0));
+    return (pixels > 32) ? pixels - 32 : 0;
+}
+
 // LsbExtracter
 LsbExtracter::LsbExtracter(Decoder* decoder)
     : _extracter(new impl::LsbExtracter(decoder)) {}
@@ -206,8 +348,16 @@ LsbExtracter::~LsbExtracter() noexcept {
 
 void LsbExtracter::setImage(const std::string& src) { _extracter->setImage(src); }
 
+void LsbExtracter::setImage(const std::vector<uint8_t>& buf) { _extracter->setImage(buf); }
+
+void LsbExtracter::setImage(const cv::Mat& image) { _extracter->setImage(image); }
+
 void LsbExtracter::setSecretKey(const std::string& key) { _extracter->setSecretKey(key); }
 
 std::string LsbExtracter::extractMessage() { return _extracter->extractMessage(); }
 
+void LsbExtracter::extractMessage(std::ostream& stream) {
+    _extracter->extractMessage(stream);
+}
+
 } // namespace imagestego
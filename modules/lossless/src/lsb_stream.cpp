@@ -0,0 +1,247 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/algorithm/lsb_stream.hpp"
+#include "imagestego/core/bitarray.hpp"
+#include "route.hpp"
+// c++ headers
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace imagestego {
+
+namespace impl {
+
+namespace {
+
+void checkStrip(const cv::Size& size, const cv::Mat& strip, int y) {
+    if (strip.type() != CV_8UC3 || strip.cols != size.width || y < 0 ||
+        y + strip.rows > size.height)
+        throw Exception(Exception::Codes::InvalidStrip);
+}
+
+/**
+ * Calls f(pixel, i) for every pixel of strip whose route index i is less than last.
+ * Pixels are mapped back to route indices, so no route points are stored.
+ */
+template<class Mat, class Func>
+void forEachPoint(const Route& route, Mat& strip, int y, std::size_t last, Func f) {
+    uint64_t idx = static_cast<uint64_t>(y) * strip.cols;
+    for (int row = 0; row != strip.rows; ++row)
+        for (int col = 0; col != strip.cols; ++col, ++idx) {
+            const std::size_t i = route.index(idx);
+            if (i < last)
+                f(strip.template at<cv::Vec3b>(row, col), i);
+        }
+}
+
+} // namespace
+
+class LsbStripEmbedder final {
+public:
+    explicit LsbStripEmbedder(Encoder* encoder = nullptr) noexcept
+        : _encoder(encoder) {}
+    virtual ~LsbStripEmbedder() noexcept {
+        if (_encoder)
+            delete _encoder;
+    }
+    void setImageSize(const cv::Size& size) { _size = size; }
+    void setMessage(const std::string& msg) {
+        if (_encoder) {
+            _encoder->setMessage(msg);
+            _msg = _encoder->getEncodedMessage();
+        } else {
+            _msg = imagestego::BitArray::fromByteString(msg);
+        }
+    }
+    void setSecretKey(const std::string& key) {
+        _key = imagestego::BitArray::fromByteString(key);
+        _seed = hash(key);
+    }
+    void embedStrip(cv::Mat& strip, int y) {
+        if (_key.empty())
+            throw Exception(Exception::Codes::NoKeyFound);
+        checkStrip(_size, strip, y);
+        std::mt19937 gen(_seed);
+        Route r(std::make_pair(_size.width, _size.height), gen);
+        // first 32 points hold message size, the rest hold message itself
+        r.create(32 + _msg.size());
+        const uint64_t sz = _msg.size();
+        forEachPoint(r, strip, y, r.size(), [&](cv::Vec3b& pixel, std::size_t i) {
+            const bool bit = (i < 32) ? ((sz >> (31 - i)) & 1u) != 0 : _msg[i - 32];
+            const bool b = (pixel.val[0] & 1u) != 0;
+            const int channel = (_key[i % _key.size()] != b) ? 1 : 2;
+            if (bit)
+                pixel.val[channel] |= 1u;
+            else
+                pixel.val[channel] &= ~1u;
+        });
+    }
+
+private:
+    Encoder* _encoder = nullptr;
+    uint32_t _seed = 0;
+    cv::Size _size;
+    imagestego::BitArray _key, _msg;
+}; // class LsbStripEmbedder
+
+class LsbStripExtracter final {
+public:
+    explicit LsbStripExtracter(Decoder* decoder = nullptr) noexcept
+        : _decoder(decoder) {}
+    virtual ~LsbStripExtracter() noexcept {
+        if (_decoder)
+            delete _decoder;
+    }
+    void setImageSize(const cv::Size& size) {
+        _size = size;
+        reset();
+    }
+    void setSecretKey(const std::string& key) {
+        _key = imagestego::BitArray::fromByteString(key);
+        _seed = hash(key);
+        reset();
+    }
+    void extractStrip(const cv::Mat& strip, int y) {
+        if (_key.empty())
+            throw Exception(Exception::Codes::NoKeyFound);
+        checkStrip(_size, strip, y);
+        std::mt19937 gen(_seed);
+        Route r(std::make_pair(_size.width, _size.height), gen);
+        if (_bits.empty()) {
+            _bits.resize(32);
+            _have.resize(32);
+        }
+        read(r, strip, y);
+        if (!_sized && _found == 32) {
+            uint64_t size = 0;
+            for (std::size_t i = 0; i != 32; ++i)
+                size = (size << 1) | (_bits[i] ? 1u : 0u);
+            r.create(32 + size);
+            _bits.resize(r.size());
+            _have.resize(r.size());
+            _sized = true;
+            // current strip may hold message bits as well
+            read(r, strip, y);
+        }
+    }
+    bool complete() const noexcept { return _sized && _found == _bits.size(); }
+    std::string extractMessage() {
+        if (!complete())
+            throw Exception(Exception::Codes::IncompleteImage);
+        imagestego::BitArray msg;
+        for (std::size_t i = 32; i != _bits.size(); ++i)
+            msg.pushBack(_bits[i]);
+        if (_decoder) {
+            _decoder->setMessage(msg);
+            return _decoder->getDecodedMessage();
+        } else {
+            return msg.toByteString();
+        }
+    }
+
+private:
+    void reset() {
+        _bits.clear();
+        _have.clear();
+        _found = 0;
+        _sized = false;
+    }
+    void read(const Route& route, const cv::Mat& strip, int y) {
+        forEachPoint(route, strip, y, _bits.size(),
+                     [&](const cv::Vec3b& pixel, std::size_t i) {
+                         // strips may be passed more than once
+                         if (_have[i])
+                             return;
+                         const bool b = (pixel.val[0] & 1u) != 0;
+                         const int channel = (_key[i % _key.size()] != b) ? 1 : 2;
+                         _bits[i] = (pixel.val[channel] & 1u) != 0;
+                         _have[i] = true;
+                         ++_found;
+                     });
+    }
+
+    Decoder* _decoder;
+    uint32_t _seed = 0;
+    cv::Size _size;
+    imagestego::BitArray _key;
+    /** bits indexed by route point, size first and message then */
+    std::vector<bool> _bits, _have;
+    std::size_t _found = 0;
+    bool _sized = false;
+}; // class LsbStripExtracter
+
+} // namespace impl
+
+// LsbStripEmbedder
+LsbStripEmbedder::LsbStripEmbedder(Encoder* encoder)
+    : _embedder(new impl::LsbStripEmbedder(encoder)) {}
+
+LsbStripEmbedder::~LsbStripEmbedder() noexcept {
+    if (_embedder)
+        delete _embedder;
+}
+
+void LsbStripEmbedder::setImageSize(const cv::Size& size) {
+    _embedder->setImageSize(size);
+}
+
+void LsbStripEmbedder::setMessage(const std::string& msg) { _embedder->setMessage(msg); }
+
+void LsbStripEmbedder::setSecretKey(const std::string& key) {
+    _embedder->setSecretKey(key);
+}
+
+void LsbStripEmbedder::embedStrip(cv::Mat& strip, int y) {
+    _embedder->embedStrip(strip, y);
+}
+
+// LsbStripExtracter
+LsbStripExtracter::LsbStripExtracter(Decoder* decoder)
+    : _extracter(new impl::LsbStripExtracter(decoder)) {}
+
+LsbStripExtracter::~LsbStripExtracter() noexcept {
+    if (_extracter)
+        delete _extracter;
+}
+
+void LsbStripExtracter::setImageSize(const cv::Size& size) {
+    _extracter->setImageSize(size);
+}
+
+void LsbStripExtracter::setSecretKey(const std::string& key) {
+    _extracter->setSecretKey(key);
+}
+
+void LsbStripExtracter::extractStrip(const cv::Mat& strip, int y) {
+    _extracter->extractStrip(strip, y);
+}
+
+bool LsbStripExtracter::complete() const noexcept { return _extracter->complete(); }
+
+std::string LsbStripExtracter::extractMessage() { return _extracter->extractMessage(); }
+
+} // namespace imagestego
@@ -24,46 +24,42 @@
 
 // imagestego headers
 #include "route.hpp"
+#include "imagestego/core/exception.hpp"
 // c++ headers
+#include <algorithm>
 #include <random>
 #include <utility>
+#include <vector>
 
 namespace imagestego {
 
-RouteImpl::RouteImpl(const std::pair<int, int>& mapSize, std::mt19937& _gen) noexcept
-    : AvlTree(), _mapSize(mapSize), gen(_gen) {}
-
-void RouteImpl::create(std::size_t n) {
-    while (size() != n) {
-        insert({gen() % _mapSize.first, gen() % _mapSize.second});
-    }
-}
-
-void RouteImpl::add() {
-    auto sz = size();
-    while (size() != sz + 1) {
-        insert({gen() % _mapSize.first, gen() % _mapSize.second});
-    }
-}
-
-void Route::setMapSize(const std::pair<int, int>& p) { _route->setMapSize(p); }
-
 Route::Route(const std::pair<int, int>& mapSize, std::mt19937& gen)
-    : _route(new RouteImpl(mapSize, gen)) {}
+    : _cols(mapSize.first > 0 ? mapSize.first : 1),
+      _perm(static_cast<uint64_t>(mapSize.first > 0 ? mapSize.first : 0) *
+                static_cast<uint64_t>(mapSize.second > 0 ? mapSize.second : 0),
+            gen) {}
 
-Route::~Route() noexcept {
-    if (_route)
-        delete _route;
+void Route::create(std::size_t n) {
+    if (n > capacity())
+        throw Exception(Exception::Codes::BigMessageSize);
+    if (n > _sz)
+        _sz = n;
 }
 
-void Route::create(std::size_t n) { _route->create(n); }
+void Route::add() { create(_sz + 1); }
 
-void Route::add() { _route->add(); }
-
-typename Route::iterator Route::begin() { return _route->begin(); }
+std::vector<std::pair<uint64_t, std::size_t>> Route::sorted(std::size_t first,
+                                                            std::size_t last) const {
+    std::vector<std::pair<uint64_t, std::size_t>> points;
+    points.reserve(last - first);
+    for (std::size_t i = first; i != last; ++i)
+        points.emplace_back(_perm[i], i);
+    std::sort(points.begin(), points.end());
+    return points;
+}
 
-typename Route::iterator Route::end() { return _route->end(); }
+Route::iterator Route::begin() const noexcept { return iterator(this, 0); }
 
-bool Route::search(const std::pair<int, int>& p) { return _route->search(p); }
+Route::iterator Route::end() const noexcept { return iterator(this, _sz); }
 
 } // namespace imagestego
@@ -26,45 +26,140 @@
 #define __IMAGESTEGO_CORE_ROUTE_HPP_INCLUDED__
 
 // imagestego headers
-#include "avl_tree.hpp"
+#include "imagestego/core/config.hpp"
+#include "imagestego/core/permutation.hpp"
 // c++ headers
+#include <iterator>
 #include <random>
 #include <utility>
+#include <vector>
 
 namespace imagestego {
 
-class RouteImpl final : public AvlTree<std::pair<int, int>, PairComparator<int, int>> {
+/**
+ * @brief Keyed pseudo-random route over the pixels of an image.
+ *
+ * Route consists of the first size() elements of a keyed permutation of pixel
+ * indices, so every point is distinct and the k-th point is computed in O(1).
+ */
+class IMAGESTEGO_EXPORTS Route {
 public:
-    explicit RouteImpl(const std::pair<int, int>& mapSize, std::mt19937&) noexcept;
-    template<class It>
-    explicit RouteImpl(It begin, It end, std::mt19937& _gen)
-        : AvlTree(begin, end), gen(_gen) {}
-    inline void setMapSize(const std::pair<int, int>& mapSize) { _mapSize = mapSize; }
-    void create(std::size_t);
-    void add();
+    class iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<int, int> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
 
-private:
-    std::pair<int, int> _mapSize;
-    std::mt19937& gen;
-}; // class RouteImpl
+        explicit iterator(const Route* route, std::size_t idx) noexcept
+            : _route(route), _idx(idx) {}
+        inline reference operator*() {
+            _value = (*_route)[_idx];
+            return _value;
+        }
+        inline pointer operator->() { return &**this; }
+        inline iterator& operator++() noexcept {
+            ++_idx;
+            return *this;
+        }
+        inline iterator operator++(int) noexcept {
+            iterator tmp = *this;
+            ++_idx;
+            return tmp;
+        }
+        inline bool operator==(const iterator& other) const noexcept {
+            return _idx == other._idx;
+        }
+        inline bool operator!=(const iterator& other) const noexcept {
+            return _idx != other._idx;
+        }
 
-class IMAGESTEGO_EXPORTS Route {
-public:
-    typedef RouteImpl::iterator iterator;
+    private:
+        const Route* _route;
+        std::size_t _idx;
+        value_type _value;
+    }; // class iterator
+
+    /**
+     * Constructs empty route.
+     *
+     * @param mapSize Size of the map as (cols, rows).
+     * @param gen PRNG used to key the permutation.
+     */
     explicit Route(const std::pair<int, int>& mapSize, std::mt19937& gen);
-    template<class It>
-    explicit Route(It begin, It end, std::mt19937& _gen)
-        : _route(new RouteImpl(begin, end, _gen)) {}
-    virtual ~Route() noexcept;
-    void setMapSize(const std::pair<int, int>& mapSize);
+
+    /**
+     * Extends route to n points.
+     *
+     * @param n Number of points.
+     */
     void create(std::size_t n);
+
+    /**
+     * Extends route by one point.
+     */
     void add();
-    bool search(const std::pair<int, int>& p);
-    iterator begin();
-    iterator end();
+
+    /**
+     * Computes i-th point of route.
+     *
+     * @param i Index of point.
+     * @return Point as (x, y) pair.
+     */
+    inline std::pair<int, int> operator[](std::size_t i) const noexcept {
+        const uint64_t idx = _perm[i];
+        return std::make_pair(static_cast<int>(idx % _cols),
+                              static_cast<int>(idx / _cols));
+    }
+
+    /**
+     * Computes i-th point of route as linear pixel index.
+     *
+     * @param i Index of point.
+     * @return Pixel index, i.e. y * cols + x.
+     */
+    inline uint64_t pixel(std::size_t i) const noexcept { return _perm[i]; }
+
+    /**
+     * Computes index of point lying at given pixel.
+     *
+     * @param pixel Pixel index, i.e. y * cols + x.
+     * @return Index of point, it may exceed size().
+     */
+    inline std::size_t index(uint64_t pixel) const noexcept {
+        return static_cast<std::size_t>(_perm.index(pixel));
+    }
+
+    /**
+     * Computes points [first, last) in memory order.
+     *
+     * @param first Index of the first point.
+     * @param last Index past the last point.
+     * @return Pairs of (pixel index, index of point) sorted by pixel index.
+     */
+    std::vector<std::pair<uint64_t, std::size_t>> sorted(std::size_t first,
+                                                         std::size_t last) const;
+
+    /**
+     * Number of points in route.
+     */
+    inline std::size_t size() const noexcept { return _sz; }
+
+    /**
+     * Maximal number of points, i.e. number of pixels.
+     */
+    inline std::size_t capacity() const noexcept {
+        return static_cast<std::size_t>(_perm.size());
+    }
+
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
 
 private:
-    RouteImpl* _route;
+    uint64_t _cols;
+    std::size_t _sz = 0;
+    Permutation _perm;
 }; // class Route
 
 } // namespace imagestego
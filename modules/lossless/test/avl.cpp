@@ -60,3 +60,20 @@ TEST(Core, AvlTree2) {
     v = {4, 3, 1, 5};
     EXPECT_TRUE(isEqual(tree.begin(), tree.end(), v.begin()));
 }
+
+TEST(Core, AvlTreeArena) {
+    imagestego::AvlTree<int> tree;
+    tree.reserve(1000);
+    for (int i = 0; i != 1000; ++i)
+        tree.insert((i * 379) % 1000);
+    EXPECT_EQ(tree.size(), 1000);
+    imagestego::AvlTree<int> copy = tree;
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_TRUE(tree.begin() == tree.end());
+    std::size_t n = 0;
+    for (auto it = copy.begin(); it != copy.end(); ++it, ++n)
+        EXPECT_TRUE(copy.search(*it));
+    EXPECT_EQ(n, 1000);
+    EXPECT_FALSE(copy.search(1000));
+}
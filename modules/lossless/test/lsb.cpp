@@ -28,6 +28,15 @@
 #include <imagestego/algorithm/lsb.hpp>
 #include <imagestego/compression/huffman_decoder.hpp>
 #include <imagestego/compression/huffman_encoder.hpp>
+#include <imagestego/compression/lzw_decoder.hpp>
+#include <imagestego/compression/lzw_encoder.hpp>
+// opencv headers
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+// c++ headers
+#include <sstream>
+#include <string>
+#include <vector>
 // gtest headers
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -81,6 +90,18 @@ TEST(Lossless, LsbExceptions) {
     EXPECT_THROW(ext.extractMessage(), imagestego::Exception);
 }
 
+TEST(Lossless, LsbImageType) {
+    cv::Mat gray(16, 16, CV_8UC1, cv::Scalar::all(0)),
+        bgra(16, 16, CV_8UC4, cv::Scalar::all(0));
+    const cv::Mat& constGray = gray;
+    LsbEmbedder emb;
+    EXPECT_THROW(emb.setImage(gray), imagestego::Exception);
+    EXPECT_THROW(emb.setImage(constGray), imagestego::Exception);
+    EXPECT_THROW(emb.setImage(bgra), imagestego::Exception);
+    LsbExtracter ext;
+    EXPECT_THROW(ext.setImage(constGray), imagestego::Exception);
+}
+
 TEST(Lossless, LsbHuffman) {
     LsbEmbedder emb(new HuffmanEncoder);
     emb.setImage("test.jpg");
@@ -93,3 +114,116 @@ TEST(Lossless, LsbHuffman) {
     ext.setSecretKey("key");
     EXPECT_EQ("asdasfnsfjhasjdhhjasgdasdasdasdasdasdaaasdasd", ext.extractMessage());
 }
+
+TEST(Lossless, LsbBuffer) {
+    std::vector<uint8_t> src, dst;
+    cv::imencode(".png", cv::imread("test.jpg"), src);
+    LsbEmbedder emb;
+    emb.setImage(src);
+    emb.setMessage("message!");
+    emb.setSecretKey("key");
+    emb.createStegoContainer(dst, ".png");
+
+    LsbExtracter ext;
+    ext.setImage(dst);
+    ext.setSecretKey("key");
+    EXPECT_EQ("message!", ext.extractMessage());
+}
+
+TEST(Lossless, LsbMat) {
+    const cv::Mat image = cv::imread("test.jpg");
+    const cv::Mat copy = image.clone();
+    cv::Mat dst;
+    LsbEmbedder emb;
+    emb.setImage(image);
+    emb.setMessage("message!");
+    emb.setSecretKey("key");
+    emb.createStegoContainer(dst);
+    // source is left untouched
+    EXPECT_EQ(cv::norm(image, copy), 0);
+
+    cv::Mat inplace = image.clone();
+    LsbEmbedder emb1;
+    emb1.setImage(inplace);
+    emb1.setMessage("message!");
+    emb1.setSecretKey("key");
+    emb1.createStegoContainer(dst);
+    EXPECT_EQ(dst.data, inplace.data);
+
+    LsbExtracter ext;
+    ext.setImage(inplace);
+    ext.setSecretKey("key");
+    EXPECT_EQ("message!", ext.extractMessage());
+}
+
+TEST(Lossless, LsbLargeMessage) {
+    cv::Mat image(512, 384, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    std::string msg(8192, '\0');
+    for (std::size_t i = 0; i != msg.size(); ++i)
+        msg[i] = static_cast<char>(i * 31 + 7);
+    LsbEmbedder emb;
+    emb.setImage(image);
+    emb.setMessage(msg);
+    emb.setSecretKey("key");
+    emb.createStegoContainer(image);
+
+    LsbExtracter ext;
+    ext.setImage(image);
+    ext.setSecretKey("key");
+    EXPECT_EQ(msg, ext.extractMessage());
+}
+
+TEST(Lossless, LsbStream) {
+    cv::Mat image(1024, 1024, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    std::string msg(100000, '\0');
+    for (std::size_t i = 0; i != msg.size(); ++i)
+        msg[i] = "lorem ipsum dolor sit amet "[i % 27] ^ static_cast<char>(i % 13 == 0);
+    // raw stream gives the same container as the whole message
+    cv::Mat whole = image.clone(), streamed = image.clone();
+    LsbEmbedder emb;
+    emb.setImage(whole);
+    emb.setMessage(msg);
+    emb.setSecretKey("key");
+    emb.createStegoContainer(whole);
+    std::istringstream in(msg);
+    LsbEmbedder emb1;
+    emb1.setImage(streamed);
+    emb1.setMessage(in);
+    emb1.setSecretKey("key");
+    emb1.createStegoContainer(streamed);
+    EXPECT_EQ(cv::norm(whole, streamed), 0);
+    // streaming and non-streaming encoders
+    for (int i = 0; i != 2; ++i) {
+        cv::Mat dst = image.clone();
+        Encoder* enc = i ? static_cast<Encoder*>(new LzwEncoder) : new HuffmanEncoder;
+        Decoder* dec = i ? static_cast<Decoder*>(new LzwDecoder) : new HuffmanDecoder;
+        std::istringstream src(msg);
+        LsbEmbedder emb2(enc);
+        emb2.setImage(dst);
+        emb2.setMessage(src);
+        emb2.setSecretKey("key");
+        emb2.createStegoContainer(dst);
+
+        std::ostringstream out;
+        LsbExtracter ext(dec);
+        ext.setImage(dst);
+        ext.setSecretKey("key");
+        ext.extractMessage(out);
+        EXPECT_EQ(msg, out.str());
+    }
+}
+
+TEST(Lossless, LsbCapacity) {
+    EXPECT_EQ(LsbEmbedder::capacity(cv::Size(4, 4)), 0);
+    EXPECT_EQ(LsbEmbedder::capacity(cv::Size(10, 10)), 68);
+    cv::Mat image(10, 10, CV_8UC3, cv::Scalar::all(0));
+    LsbEmbedder emb;
+    emb.setImage(image);
+    emb.setSecretKey("key");
+    emb.setMessage("8 bytes!");
+    EXPECT_NO_THROW(emb.createStegoContainer(image));
+    emb.setMessage("9 bytes!!");
+    EXPECT_THROW(emb.createStegoContainer(image), imagestego::Exception);
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/core/exception.hpp"
+#include <imagestego/algorithm/lsb.hpp>
+#include <imagestego/algorithm/lsb_stream.hpp>
+// opencv headers
+#include <opencv2/core.hpp>
+// gtest headers
+#include <gtest/gtest.h>
+
+using namespace imagestego;
+
+TEST(Lossless, LsbStripEmbedder) {
+    cv::Mat image(301, 217, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    const int strip = 7;
+
+    LsbStripEmbedder emb;
+    emb.setImageSize(image.size());
+    emb.setMessage("strip by strip message");
+    emb.setSecretKey("key");
+    // strips don't have to come in order
+    for (int y = ((image.rows - 1) / strip) * strip; y >= 0; y -= strip) {
+        cv::Mat roi = image.rowRange(y, std::min(y + strip, image.rows));
+        emb.embedStrip(roi, y);
+    }
+
+    LsbExtracter ext;
+    ext.setImage(image);
+    ext.setSecretKey("key");
+    EXPECT_EQ("strip by strip message", ext.extractMessage());
+}
+
+TEST(Lossless, LsbStripExtracter) {
+    cv::Mat image(301, 217, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    const int strip = 7;
+
+    LsbEmbedder emb;
+    emb.setImage(image);
+    emb.setMessage("strip by strip message");
+    emb.setSecretKey("key");
+    emb.createStegoContainer(image);
+
+    LsbStripExtracter ext;
+    ext.setImageSize(image.size());
+    ext.setSecretKey("key");
+    for (int pass = 0; pass != 2 && !ext.complete(); ++pass)
+        for (int y = 0; y < image.rows; y += strip)
+            ext.extractStrip(image.rowRange(y, std::min(y + strip, image.rows)), y);
+    ASSERT_TRUE(ext.complete());
+    EXPECT_EQ("strip by strip message", ext.extractMessage());
+}
+
+TEST(Lossless, LsbStripExceptions) {
+    cv::Mat image(64, 64, CV_8UC3, cv::Scalar::all(0));
+    LsbStripEmbedder emb;
+    emb.setImageSize(image.size());
+    emb.setMessage("message!");
+    EXPECT_THROW(emb.embedStrip(image, 0), imagestego::Exception);
+    emb.setSecretKey("key");
+    cv::Mat roi = image.rowRange(0, 8);
+    EXPECT_THROW(emb.embedStrip(roi, 60), imagestego::Exception);
+
+    LsbStripExtracter ext;
+    ext.setImageSize(image.size());
+    ext.setSecretKey("key");
+    EXPECT_FALSE(ext.complete());
+    EXPECT_THROW(ext.extractMessage(), imagestego::Exception);
+}
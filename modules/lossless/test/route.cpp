@@ -23,30 +23,57 @@
  */
 
 // imagestego headers
+#include "imagestego/core/exception.hpp"
 #include "route.hpp"
 // c++ headers
+#include <algorithm>
+#include <set>
 #include <vector>
 // gtest
 #include <gtest/gtest.h>
 
 using imagestego::Route;
 
-template<typename It1, typename It2>
-bool isEqual(It1 begin, It1 end, It2 _begin) {
-    for (; begin != end; ++begin, ++_begin)
-        if (*begin != *_begin)
-            return false;
-    return true;
-}
-
 TEST(Core, Route) {
     std::mt19937 gen;
     gen.seed(1);
     Route r({10, 15}, gen);
     r.create(3);
-    std::vector<std::pair<int, int>> v = {{4, 8}, {3, 13}, {5, 14}};
-    EXPECT_TRUE(isEqual(r.begin(), r.end(), v.begin()));
+    EXPECT_EQ(r.size(), 3);
+    std::vector<std::pair<int, int>> v(r.begin(), r.end());
     r.add();
-    v = {{4, 8}, {3, 13}, {1, 11}, {5, 14}};
-    EXPECT_TRUE(isEqual(r.begin(), r.end(), v.begin()));
+    EXPECT_EQ(r.size(), 4);
+    std::vector<std::pair<int, int>> v1(r.begin(), r.end());
+    // adding a point keeps the existing ones
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), v1.begin()));
+}
+
+TEST(Core, RouteCoversMap) {
+    std::mt19937 gen(42);
+    Route r({17, 23}, gen);
+    EXPECT_EQ(r.capacity(), 17 * 23);
+    r.create(r.capacity());
+    std::set<std::pair<int, int>> points;
+    for (auto it = r.begin(); it != r.end(); ++it) {
+        EXPECT_GE(it->first, 0);
+        EXPECT_LT(it->first, 17);
+        EXPECT_GE(it->second, 0);
+        EXPECT_LT(it->second, 23);
+        points.insert(*it);
+    }
+    EXPECT_EQ(points.size(), r.capacity());
+}
+
+TEST(Core, RouteDeterministic) {
+    std::mt19937 gen1(7), gen2(7);
+    Route r1({640, 480}, gen1), r2({640, 480}, gen2);
+    r1.create(1000);
+    r2.create(1000);
+    EXPECT_TRUE(std::equal(r1.begin(), r1.end(), r2.begin()));
+}
+
+TEST(Core, RouteOverflow) {
+    std::mt19937 gen;
+    Route r({4, 4}, gen);
+    EXPECT_THROW(r.create(17), imagestego::Exception);
 }
@@ -29,9 +29,12 @@
 #include "imagestego/core/config.hpp"
 #include "imagestego/core/interfaces.hpp"
 #include "imagestego/wavelet/interfaces.hpp"
+// opencv headers
+#include <opencv2/core.hpp>
 // c++ headers
 #include <random>
 #include <string>
+#include <vector>
 
 namespace imagestego {
 
@@ -69,6 +72,33 @@ public:
      */
     void setImage(const std::string& src) override;
 
+    /**
+     * Setter for image.
+     *
+     * @param buf Encoded image.
+     */
+    void setImage(const std::vector<uint8_t>& buf) override;
+
+    /**
+     * Setter for image.
+     *
+     * Image is copied, so the source stays untouched.
+     *
+     * @param image Image of type CV_8UC3.
+     * @throws imagestego::Exception if image has another type.
+     */
+    void setImage(const cv::Mat& image);
+
+    /**
+     * Setter for image.
+     *
+     * Image data is shared, so embedding is performed in-place.
+     *
+     * @param image Image of type CV_8UC3.
+     * @throws imagestego::Exception if image has another type.
+     */
+    void setImage(cv::Mat& image);
+
     /**
      * Setter for message.
      *
@@ -83,6 +113,25 @@ public:
      */
     void setSecretKey(const std::string& key) override;
 
+    /**
+     * Setter for decomposition level.
+     *
+     * Selected rectangle is decomposed into given number of levels, so the deeper
+     * the level, the bigger rectangle is needed. Default level is 1.
+     *
+     * @param level Decomposition level starting from 1.
+     */
+    void setLevel(int level);
+
+    /**
+     * Setter for subband which carries the message.
+     *
+     * Default subband is HH.
+     *
+     * @param band Subband of the chosen level.
+     */
+    void setSubband(Subband band);
+
     /**
      * Creates stego container.
      *
@@ -90,6 +139,38 @@ public:
      */
     void createStegoContainer(const std::string& dst) override;
 
+    /**
+     * Creates stego container.
+     *
+     * @param dst Buffer for encoded image.
+     * @param ext Extension defining image format, e.g. ".png".
+     */
+    void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) override;
+
+    /**
+     * Creates stego container.
+     *
+     * @param dst Image with embedded message, shares data with source image.
+     */
+    void createStegoContainer(cv::Mat& dst);
+
+    /**
+     * Computes maximal message length for given image.
+     *
+     * Message is embedded into randomly placed rectangle below the stored message
+     * size. Size of the rectangle is drawn among the ones which carry the message,
+     * so any message of at most capacity() bits is embedded completely, longer ones
+     * are rejected by createStegoContainer().
+     *
+     * @param size Image size.
+     * @param level Decomposition level.
+     * @param band Subband which carries the message.
+     * @return Number of bits available for encoded message.
+     * @throws imagestego::Exception if level is invalid.
+     */
+    static std::size_t capacity(const cv::Size& size, int level = 1,
+                                Subband band = Subband::HH);
+
 private:
     impl::WaveletEmbedder* _pImpl;
 }; // class WaveletEmbedder
@@ -114,10 +195,28 @@ public:
      * @brief Source image setter.
      */
     void setImage(const std::string& imageName) override;
+    /**
+     * @brief Source image setter from encoded image buffer.
+     */
+    void setImage(const std::vector<uint8_t>& buf) override;
+    /**
+     * @brief Source image setter, image data is shared.
+     *
+     * @throws imagestego::Exception if image type isn't CV_8UC3.
+     */
+    void setImage(const cv::Mat& image);
     /**
      * @brief Setter for secret key.
      */
     void setSecretKey(const std::string& key) override;
+    /**
+     * @brief Setter for decomposition level, must match the one used for embedding.
+     */
+    void setLevel(int level);
+    /**
+     * @brief Setter for subband, must match the one used for embedding.
+     */
+    void setSubband(Subband band);
     /**
      * @brief Function for extracting secret message.
      */
@@ -0,0 +1,83 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_WAVELET_BACKEND_HPP_INCLUDED__
+#define __IMAGESTEGO_WAVELET_BACKEND_HPP_INCLUDED__
+
+// imagestego headers
+#include "imagestego/core/config.hpp"
+
+namespace imagestego {
+
+/**
+ * @brief Instruction sets for experimental::HaarWavelet kernels.
+ *
+ * Kernels for every instruction set the compiler can emit are built into the
+ * library. One of them is picked at runtime according to the CPU.
+ */
+enum class HaarBackend { Scalar, Sse, Avx2, Avx512, Neon };
+
+/**
+ * @brief Returns backend currently used by experimental::HaarWavelet.
+ *
+ * By default it is the fastest backend available on this CPU.
+ *
+ * @return Current backend.
+ */
+IMAGESTEGO_EXPORTS HaarBackend haarBackend() noexcept;
+
+/**
+ * @brief Checks if backend is built into library and supported by CPU.
+ *
+ * @param backend Backend to check.
+ * @return true if backend can be used.
+ */
+IMAGESTEGO_EXPORTS bool isHaarBackendAvailable(HaarBackend backend) noexcept;
+
+/**
+ * @brief Forces given backend for the whole process.
+ *
+ * Intended for testing and benchmarking. Does nothing if backend is not available.
+ *
+ * @param backend Backend to be used.
+ * @return true if backend was set.
+ */
+IMAGESTEGO_EXPORTS bool setHaarBackend(HaarBackend backend) noexcept;
+
+/**
+ * @brief Restores backend chosen by CPU detection.
+ */
+IMAGESTEGO_EXPORTS void resetHaarBackend() noexcept;
+
+/**
+ * @brief Returns human-readable backend name.
+ *
+ * @param backend Backend.
+ * @return Null-terminated name, e.g. "avx2".
+ */
+IMAGESTEGO_EXPORTS const char* haarBackendName(HaarBackend backend) noexcept;
+
+} // namespace imagestego
+
+#endif /* __IMAGESTEGO_WAVELET_BACKEND_HPP_INCLUDED__ */
@@ -27,6 +27,7 @@
 
 // imagestego headers
 #include "imagestego/core/config.hpp"
+#include "imagestego/wavelet/backend.hpp"
 #include "imagestego/wavelet/interfaces.hpp"
 // opencv headers
 #include <opencv2/core/mat.hpp>
@@ -41,6 +42,9 @@ class HaarWavelet;
 
 /**
  * @brief Class which implements Haar wavelet.
+ *
+ * Channels are transformed without splitting interleaved data, 8-bit input is widened
+ * on the fly. Large images are split into row bands processed by sharedThreadPool().
  */
 class IMAGESTEGO_EXPORTS HaarWavelet : public Wavelet {
 public:
@@ -55,6 +59,13 @@ public:
      * @return Transformed matrix.
      */
     cv::Mat transform(const cv::Mat& mat) override;
+    /**
+     * @brief Transforms given matrix into given matrix, see Wavelet::transformTo().
+     *
+     * @param src Matrix to be transformed.
+     * @param dst Destination matrix.
+     */
+    void transformTo(const cv::Mat& src, cv::Mat& dst) override;
     /**
      * @brief Applies inverse transform.
      *
@@ -62,6 +73,13 @@ public:
      * @return Transformed matrix.
      */
     cv::Mat inverse(const cv::Mat& mat) override;
+    /**
+     * @brief Applies inverse transform into given matrix, see Wavelet::inverseTo().
+     *
+     * @param src Matrix to be transformed.
+     * @param dst Destination matrix.
+     */
+    void inverseTo(const cv::Mat& src, cv::Mat& dst) override;
     virtual ~HaarWavelet() noexcept;
 
 private:
@@ -78,6 +96,9 @@ class HaarWavelet;
 
 /**
  * @brief SIMD-accelerated Haar wavelet.
+ *
+ * Kernels are chosen at runtime, see haarBackend(). Threading is the same as in
+ * imagestego::HaarWavelet.
  */
 class IMAGESTEGO_EXPORTS HaarWavelet : public Wavelet {
 public:
@@ -92,6 +113,13 @@ public:
      * @return Transformed matrix.
      */
     cv::Mat transform(const cv::Mat& mat) override;
+    /**
+     * @brief Transforms given matrix into given matrix, see Wavelet::transformTo().
+     *
+     * @param src Matrix to be transformed.
+     * @param dst Destination matrix.
+     */
+    void transformTo(const cv::Mat& src, cv::Mat& dst) override;
     /**
      * @brief Applies inverse transform.
      *
@@ -99,6 +127,13 @@ public:
      * @return Transformed matrix.
      */
     cv::Mat inverse(const cv::Mat& mat) override;
+    /**
+     * @brief Applies inverse transform into given matrix, see Wavelet::inverseTo().
+     *
+     * @param src Matrix to be transformed.
+     * @param dst Destination matrix.
+     */
+    void inverseTo(const cv::Mat& src, cv::Mat& dst) override;
     virtual ~HaarWavelet() noexcept;
 
 private:
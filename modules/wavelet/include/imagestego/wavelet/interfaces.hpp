@@ -32,6 +32,27 @@
 
 namespace imagestego {
 
+/**
+ * @brief Subbands of one decomposition level.
+ *
+ * First letter stands for horizontal filter, second one for vertical, e.g. HL holds
+ * horizontal details of vertically smoothed image.
+ */
+enum class Subband { LL, HL, LH, HH };
+
+/**
+ * @brief Location of subband in decomposed matrix.
+ *
+ * Decomposition follows Mallat layout: each level splits LL subband of the previous
+ * one into four quadrants. Odd last row and column are not part of any subband.
+ *
+ * @param size Size of the original matrix.
+ * @param level Decomposition level starting from 1.
+ * @param band Subband.
+ * @return Subband rectangle, empty if level is too deep for given size.
+ */
+IMAGESTEGO_EXPORTS cv::Rect subbandRect(const cv::Size& size, int level, Subband band);
+
 /**
  * @brief Interface for custom wavelet schemes.
  */
@@ -44,6 +65,17 @@ public:
      * @return Transformed matrix.
      */
     virtual cv::Mat transform(const cv::Mat& src) = 0;
+    /**
+     * @brief Transforms given matrix and stores result into given matrix.
+     *
+     * If dst is CV_16S matrix with the same size and number of channels as src, it is
+     * written in-place, e.g. ROI of a bigger scratch buffer. Otherwise dst is
+     * reallocated. Default implementation copies result of transform().
+     *
+     * @param src Matrix to be transformed.
+     * @param dst Destination matrix, must not overlap src.
+     */
+    virtual void transformTo(const cv::Mat& src, cv::Mat& dst);
     /**
      * @brief Method applying inverse transform on given matrix.
      *
@@ -51,6 +83,54 @@ public:
      * @return Transformed matrix.
      */
     virtual cv::Mat inverse(const cv::Mat& src) = 0;
+    /**
+     * @brief Applies inverse transform and stores result into given matrix.
+     *
+     * If dst has the same size and number of channels as src, it is written in-place
+     * and its depth is kept, values are saturated. It allows restoring e.g. 8-bit ROI of
+     * an image without intermediate 16-bit copy. Otherwise dst is reallocated as CV_16S.
+     * Default implementation converts result of inverse().
+     *
+     * @param src Matrix to be transformed.
+     * @param dst Destination matrix.
+     */
+    virtual void inverseTo(const cv::Mat& src, cv::Mat& dst);
+    /**
+     * @brief Multi-level decomposition.
+     *
+     * Each level transforms only LL subband of the previous one, the result is
+     * written back into the same matrix. Deeper levels go through one scratch buffer
+     * of the first level LL size.
+     *
+     * @param src Matrix to be transformed.
+     * @param levels Number of levels.
+     * @return Transformed matrix of type CV_16S.
+     * @throws imagestego::Exception if matrix is too small for given levels.
+     */
+    cv::Mat decompose(const cv::Mat& src, int levels);
+    /**
+     * @brief Inverse of multi-level decomposition.
+     *
+     * @param src Matrix obtained from decompose().
+     * @param levels Number of levels.
+     * @return Reconstructed matrix of type CV_16S.
+     * @throws imagestego::Exception if matrix is too small for given levels.
+     */
+    cv::Mat reconstruct(const cv::Mat& src, int levels);
+    /**
+     * @brief Inverse of multi-level decomposition into given matrix.
+     *
+     * Deeper levels are restored in place: LL subband of every level but the last one
+     * is overwritten in src through one scratch buffer of the first level LL size, so
+     * src is consumed. Last level is restored by inverseTo(), see it for destination
+     * requirements.
+     *
+     * @param src Matrix obtained from decompose(), used as working space.
+     * @param levels Number of levels.
+     * @param dst Destination matrix, must not overlap src.
+     * @throws imagestego::Exception if matrix is too small for given levels.
+     */
+    void reconstructTo(cv::Mat& src, int levels, cv::Mat& dst);
     virtual ~Wavelet() noexcept = default;
 }; // class Wavelet
 
@@ -31,6 +31,8 @@
 #include <iostream>
 // opencv
 #include <opencv2/core.hpp>
+// gtest
+#include <gtest/gtest.h>
 
 namespace chrono = std::chrono;
 
@@ -194,7 +196,7 @@ void test501x303() {
     std::cout << "Total speedup is: " << double(ns.count()) / ns1.count() << std::endl;
 }
 
-int main() {
+TEST(Wavelet, HaarPerf) {
     test256x256();
     test320x320();
     test501x303();
@@ -202,5 +204,4 @@ int main() {
     testFullHD();
     test2K();
     test4K();
-    return 0;
 }
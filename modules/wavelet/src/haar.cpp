@@ -24,117 +24,235 @@
 
 // imagestego headers
 #include "imagestego/wavelet/haar.hpp"
+#include "imagestego/core/thread_pool.hpp"
 #include "haar.hpp"
 #include "inverse_haar.hpp"
 // c++ headers
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <future>
+#include <type_traits>
 #include <vector>
 // opencv headers
 #include <opencv2/core.hpp>
 
 namespace imagestego {
 
-namespace experimental {
-
 namespace impl {
 
-class HaarWavelet;
+namespace {
+
+typedef void (*VerticalRow)(const int16_t*, const int16_t*, int16_t*, int16_t*, int);
+typedef void (*HorizontalRow)(const int16_t*, int16_t*, int);
+
+struct RowKernels {
+    VerticalRow vertical;
+    HorizontalRow horizontal;
+    VerticalRow inverseVertical;
+    HorizontalRow inverseHorizontal;
+};
+
+// approximate number of elements processed by one task
+const int bandSize = 1 << 16;
 
+/*
+ * Applies single-channel row kernel to every channel of interleaved row. Channel is
+ * gathered into buf (2 * cols elements) and scattered back, so planes are never split.
+ * Widening of 8-bit input and saturating store of 8-bit output are done on the fly.
+ */
+template<class T, class U>
+void channelwise(HorizontalRow kernel, const T* src, U* dst, const int cols, const int channels,
+                 int16_t* buf) {
+    if (std::is_same<T, int16_t>::value && std::is_same<U, int16_t>::value && channels == 1) {
+        kernel(reinterpret_cast<const int16_t*>(src), reinterpret_cast<int16_t*>(dst), cols);
+        return;
+    }
+    int16_t* in = buf;
+    int16_t* out = buf + cols;
+    for (int c = 0; c != channels; ++c) {
+        for (int j = 0; j != cols; ++j) {
+            in[j] = src[j * channels + c];
+        }
+        kernel(in, out, cols);
+        for (int j = 0; j != cols; ++j) {
+            dst[j * channels + c] = cv::saturate_cast<U>(out[j]);
+        }
+    }
 }
 
+// number of row pairs processed by one task
+int bandRows(const cv::Mat& mat) {
+    return std::max(1, bandSize / (2 * mat.cols * mat.channels()));
 }
 
-namespace impl {
+/*
+ * Both passes are fused: every task takes a band of row pairs, lifts two rows
+ * horizontally into its own buffer and then vertically into destination, so whole
+ * image is read and written once. Images smaller than one band stay on calling thread.
+ */
+template<class T>
+void forward(const cv::Mat& src, cv::Mat& dst, const RowKernels& k) {
+    const int cols = src.cols, channels = src.channels(), width = cols * channels;
+    const int half = src.rows / 2, band = bandRows(src);
+    parallelFor((half + band - 1) / band, [&](std::size_t idx) {
+        std::vector<int16_t> buf(2 * width + 2 * cols);
+        int16_t* a = buf.data();
+        int16_t* b = a + width;
+        const int first = static_cast<int>(idx) * band, last = std::min(half, first + band);
+        for (int i = first; i != last; ++i) {
+            channelwise(k.horizontal, src.ptr<T>(i << 1), a, cols, channels, b + width);
+            channelwise(k.horizontal, src.ptr<T>((i << 1) + 1), b, cols, channels, b + width);
+            k.vertical(a, b, dst.ptr<int16_t>(i), dst.ptr<int16_t>(i + half), width);
+        }
+    });
+    // odd last row has no pair
+    if (src.rows & 1) {
+        std::vector<int16_t> buf(2 * cols);
+        channelwise(k.horizontal, src.ptr<T>(src.rows - 1), dst.ptr<int16_t>(src.rows - 1),
+                    cols, channels, buf.data());
+    }
+}
+
+template<class U>
+void backward(const cv::Mat& src, cv::Mat& dst, const RowKernels& k) {
+    const int cols = src.cols, channels = src.channels(), width = cols * channels;
+    const int half = src.rows / 2, band = bandRows(src);
+    parallelFor((half + band - 1) / band, [&](std::size_t idx) {
+        std::vector<int16_t> buf(2 * width + 2 * cols);
+        int16_t* a = buf.data();
+        int16_t* b = a + width;
+        const int first = static_cast<int>(idx) * band, last = std::min(half, first + band);
+        for (int i = first; i != last; ++i) {
+            k.inverseVertical(src.ptr<int16_t>(i), src.ptr<int16_t>(i + half), a, b, width);
+            channelwise(k.inverseHorizontal, a, dst.ptr<U>(i << 1), cols, channels, b + width);
+            channelwise(k.inverseHorizontal, b, dst.ptr<U>((i << 1) + 1), cols, channels,
+                        b + width);
+        }
+    });
+    if (src.rows & 1) {
+        std::vector<int16_t> buf(2 * cols);
+        channelwise(k.inverseHorizontal, src.ptr<int16_t>(src.rows - 1),
+                    dst.ptr<U>(src.rows - 1), cols, channels, buf.data());
+    }
+}
+
+/*
+ * Destination is reused if it's already 16-bit matrix of proper size, otherwise it is
+ * reallocated.
+ */
+void transform(const cv::Mat& src, cv::Mat& dst, const RowKernels& k) {
+    const int type = CV_MAKETYPE(CV_16S, src.channels());
+    if (dst.size() != src.size() || dst.type() != type || dst.data == src.data) {
+        dst.create(src.size(), type);
+    }
+    switch (src.depth()) {
+        case CV_8U:
+            forward<uint8_t>(src, dst, k);
+            break;
+        case CV_16S:
+            forward<int16_t>(src, dst, k);
+            break;
+        default: {
+            cv::Mat tmp;
+            src.convertTo(tmp, CV_16S);
+            forward<int16_t>(tmp, dst, k);
+        }
+    }
+}
+
+/*
+ * Coefficients are expected to be 16-bit. Destination keeps its depth if it already has
+ * proper size, otherwise it is allocated as 16-bit.
+ */
+void inverse(const cv::Mat& src, cv::Mat& dst, const RowKernels& k) {
+    cv::Mat coeffs = src;
+    if (src.depth() != CV_16S) {
+        src.convertTo(coeffs, CV_16S);
+    }
+    if (dst.size() != src.size() || dst.channels() != src.channels() || dst.data == src.data) {
+        dst.create(src.size(), coeffs.type());
+    }
+    switch (dst.depth()) {
+        case CV_8U:
+            backward<uint8_t>(coeffs, dst, k);
+            break;
+        case CV_16S:
+            backward<int16_t>(coeffs, dst, k);
+            break;
+        default: {
+            cv::Mat tmp(src.size(), coeffs.type());
+            backward<int16_t>(coeffs, tmp, k);
+            tmp.convertTo(dst, dst.depth());
+        }
+    }
+}
+
+} // namespace
 
 class HaarWavelet final {
 public:
     explicit HaarWavelet() noexcept {}
     cv::Mat transform(const cv::Mat& mat) {
         cv::Mat dst;
-        std::vector<cv::Mat> planes, _planes;
-        if (mat.depth() != CV_16S) {
-            mat.convertTo(dst, CV_16S);
-            cv::split(dst, _planes);
-        } else {
-            cv::split(mat, _planes);
-        }
-        std::vector<std::future<cv::Mat>> futures;
-        futures.reserve(_planes.size() - 1);
-        for (std::size_t i = 1; i != _planes.size(); ++i) {
-            futures.emplace_back(std::async(
-                [](const cv::Mat& src) {
-                    return verticalLifting(horizontalLifting(src));
-                },
-                std::cref(_planes[i])));
-        }
-        planes.reserve(_planes.size());
-        planes.emplace_back(verticalLifting(horizontalLifting(_planes.front())));
-        for (auto&& f : futures) {
-            planes.emplace_back(f.get());
-        }
-        cv::merge(planes, dst);
+        impl::transform(mat, dst, kernels);
         return dst;
     }
+    void transformTo(const cv::Mat& src, cv::Mat& dst) {
+        impl::transform(src, dst, kernels);
+    }
     cv::Mat inverse(const cv::Mat& mat) {
         cv::Mat dst;
-        std::vector<cv::Mat> planes, _planes;
-        cv::split(mat, _planes);
-        std::vector<std::future<cv::Mat>> futures;
-        futures.reserve(_planes.size());
-        for (const cv::Mat& mat_ : _planes) {
-            futures.emplace_back(std::async(
-                [](const cv::Mat& src) {
-                    return inverseHorizontalLifting(inverseVerticalLifting(src));
-                },
-                std::cref(mat_)));
-        }
-        planes.reserve(_planes.size());
-        for (auto&& f : futures) {
-            planes.emplace_back(f.get());
-        }
-        cv::merge(planes, dst);
+        impl::inverse(mat, dst, kernels);
         return dst;
     }
+    void inverseTo(const cv::Mat& src, cv::Mat& dst) { impl::inverse(src, dst, kernels); }
 
 private:
-    static cv::Mat horizontalLifting(const cv::Mat& src) {
-        cv::Mat dst(src.size(), CV_16S);
-        src.copyTo(dst);
-        auto x = src.cols >> 1;
-        for (int i = 0; i != src.rows; ++i) {
-            for (int j = 0; j != x; ++j) {
-                auto a = src.at<int16_t>(i, (j << 1)),
-                     b = src.at<int16_t>(i, (j << 1) + 1);
-                dst.at<int16_t>(i, j) = floor2(a + b);
-                dst.at<int16_t>(i, j + x) = a - b;
-            }
+    static const RowKernels kernels;
+
+    static void horizontalLifting(const int16_t* src, int16_t* dst, const int cols) {
+        const int x = cols >> 1;
+        for (int j = 0; j != x; ++j) {
+            const int a = src[j << 1], b = src[(j << 1) + 1];
+            dst[j] = floor2(a + b);
+            dst[j + x] = a - b;
         }
-        return dst;
+        copyLastColumn(src, dst, cols);
     }
-    static inline cv::Mat verticalLifting(const cv::Mat& src) {
-        return horizontalLifting(src.t()).t();
-    }
-    static cv::Mat inverseHorizontalLifting(const cv::Mat& src) {
-        cv::Mat dst(src.size(), CV_16SC1);
-        src.copyTo(dst);
-        auto x = src.cols >> 1;
-        for (int i = 0; i != src.rows; ++i) {
-            for (int j = 0; j != x; ++j) {
-                auto a = src.at<short>(i, j), b = src.at<short>(i, j + x);
-                dst.at<short>(i, (j << 1)) = a + floor2(b + 1);
-                dst.at<short>(i, (j << 1) + 1) = a - floor2(b);
-            }
+    static void verticalLifting(const int16_t* a, const int16_t* b, int16_t* lo, int16_t* hi,
+                                const int cols) {
+        for (int j = 0; j != cols; ++j) {
+            lo[j] = floor2(a[j] + b[j]);
+            hi[j] = a[j] - b[j];
         }
-        return dst;
     }
-    static inline cv::Mat inverseVerticalLifting(const cv::Mat& src) {
-        return inverseHorizontalLifting(src.t()).t();
+    static void inverseHorizontalLifting(const int16_t* src, int16_t* dst, const int cols) {
+        const int x = cols >> 1;
+        for (int j = 0; j != x; ++j) {
+            const int a = src[j], b = src[j + x];
+            dst[j << 1] = a + floor2(b + 1);
+            dst[(j << 1) + 1] = a - floor2(b);
+        }
+        copyLastColumn(src, dst, cols);
+    }
+    static void inverseVerticalLifting(const int16_t* lo, const int16_t* hi, int16_t* a,
+                                       int16_t* b, const int cols) {
+        for (int j = 0; j != cols; ++j) {
+            a[j] = lo[j] + floor2(hi[j] + 1);
+            b[j] = lo[j] - floor2(hi[j]);
+        }
+    }
+    static inline void copyLastColumn(const int16_t* src, int16_t* dst, const int cols) {
+        if (cols & 1) {
+            dst[cols - 1] = src[cols - 1];
+        }
     }
     static inline int floor2(int num) { return (num < 0) ? (num - 1) / 2 : num / 2; }
-    friend class imagestego::experimental::impl::HaarWavelet;
 }; // class HaarWavelet
 
+const RowKernels HaarWavelet::kernels = {verticalLifting, horizontalLifting,
+                                         inverseVerticalLifting, inverseHorizontalLifting};
+
 } // namespace impl
 
 HaarWavelet::HaarWavelet() : pImpl(new impl::HaarWavelet) {}
@@ -146,8 +264,14 @@ HaarWavelet::~HaarWavelet() noexcept {
 
 cv::Mat HaarWavelet::transform(const cv::Mat& mat) { return pImpl->transform(mat); }
 
+void HaarWavelet::transformTo(const cv::Mat& src, cv::Mat& dst) {
+    pImpl->transformTo(src, dst);
+}
+
 cv::Mat HaarWavelet::inverse(const cv::Mat& mat) { return pImpl->inverse(mat); }
 
+void HaarWavelet::inverseTo(const cv::Mat& src, cv::Mat& dst) { pImpl->inverseTo(src, dst); }
+
 namespace experimental {
 
 namespace impl {
@@ -157,77 +281,28 @@ public:
     explicit HaarWavelet() noexcept {}
     cv::Mat transform(const cv::Mat& mat) {
         cv::Mat dst;
-        std::vector<std::future<cv::Mat>> futures;
-        std::vector<cv::Mat> planes, _planes;
-        if (mat.depth() != CV_16S) {
-            mat.convertTo(dst, CV_16S);
-            cv::split(dst, _planes);
-        } else {
-            cv::split(mat, _planes);
-        }
-
-        for (std::size_t i = 1; i != _planes.size(); ++i) {
-            futures.emplace_back(std::async(
-                [](const cv::Mat& mat) -> cv::Mat {
-                    return verticalLifting(horizontalLifting(mat));
-                },
-                std::cref(_planes[i])));
-        }
-        planes.reserve(_planes.size());
-        planes.emplace_back(verticalLifting(horizontalLifting(_planes.front())));
-        for (auto&& f : futures) {
-            planes.emplace_back(f.get());
-        }
-        cv::merge(planes, dst);
+        imagestego::impl::transform(mat, dst, kernels);
         return dst;
     }
+    void transformTo(const cv::Mat& src, cv::Mat& dst) {
+        imagestego::impl::transform(src, dst, kernels);
+    }
     cv::Mat inverse(const cv::Mat& mat) {
         cv::Mat dst;
-        std::vector<cv::Mat> planes, _planes;
-        cv::split(mat, _planes);
-        std::vector<std::future<cv::Mat>> futures;
-        futures.reserve(_planes.size());
-        for (const cv::Mat& mat_ : _planes) {
-            futures.emplace_back(std::async(
-                [](const cv::Mat& src) {
-                    return inverseHorizontalLifting(inverseVerticalLifting(src));
-                },
-                std::cref(mat_)));
-        }
-        planes.reserve(_planes.size());
-        for (auto&& f : futures) {
-            planes.emplace_back(f.get());
-        }
-        cv::merge(planes, dst);
+        imagestego::impl::inverse(mat, dst, kernels);
         return dst;
     }
+    void inverseTo(const cv::Mat& src, cv::Mat& dst) {
+        imagestego::impl::inverse(src, dst, kernels);
+    }
 
 private:
-    static cv::Mat horizontalLifting(const cv::Mat& src);
-    static cv::Mat verticalLifting(const cv::Mat& src);
-    static cv::Mat inverseVerticalLifting(const cv::Mat& src);
-    static cv::Mat inverseHorizontalLifting(const cv::Mat& src);
+    static const imagestego::impl::RowKernels kernels;
 }; // class HaarWavelet
 
-cv::Mat HaarWavelet::horizontalLifting(const cv::Mat& src) {
-    cv::Mat dst(src.size(), CV_16SC1);
-    horizontalHaar(src.data, dst.data, src.rows, src.cols);
-    return dst;
-}
-
-cv::Mat HaarWavelet::verticalLifting(const cv::Mat& src) {
-    cv::Mat dst(src.size(), CV_16SC1);
-    verticalHaar(src.data, dst.data, src.rows, src.cols);
-    return dst;
-}
-
-cv::Mat HaarWavelet::inverseHorizontalLifting(const cv::Mat& src) {
-    return imagestego::impl::HaarWavelet::inverseHorizontalLifting(src);
-}
-
-cv::Mat HaarWavelet::inverseVerticalLifting(const cv::Mat& src) {
-    return imagestego::impl::HaarWavelet::inverseVerticalLifting(src);
-}
+// dispatched kernels, backend may be switched between calls
+const imagestego::impl::RowKernels HaarWavelet::kernels = {
+    verticalHaarRow, horizontalHaarRow, inverseVerticalHaarRow, inverseHorizontalHaarRow};
 
 } // namespace impl
 
@@ -241,8 +316,14 @@ HaarWavelet::~HaarWavelet() noexcept {
 
 cv::Mat HaarWavelet::transform(const cv::Mat& mat) { return pImpl->transform(mat); }
 
+void HaarWavelet::transformTo(const cv::Mat& src, cv::Mat& dst) {
+    pImpl->transformTo(src, dst);
+}
+
 cv::Mat HaarWavelet::inverse(const cv::Mat& mat) { return pImpl->inverse(mat); }
 
+void HaarWavelet::inverseTo(const cv::Mat& src, cv::Mat& dst) { pImpl->inverseTo(src, dst); }
+
 } // namespace experimental
 
 } // namespace imagestego
@@ -32,28 +32,29 @@ extern "C" {
 #endif
 
 /**
- * Function which computes vertical lifting.
+ * Function which computes vertical lifting of a row pair.
  *
- * NB: pointers only from CV_16S matrices are accepted.
+ * Rows may be interleaved, every element is treated independently.
  *
- * @param src Pointer to source matrix obtained from cv::Mat::data.
- * @param dst Destination pointer.
- * @param rows Number of rows.
- * @param cols Number of columns.
+ * @param ptr1 Even source row.
+ * @param ptr2 Odd source row.
+ * @param loptr Destination row of low-pass coefficients.
+ * @param hiptr Destination row of high-pass coefficients.
+ * @param cols Number of elements in a row.
  */
-void verticalHaar(const uint8_t* src, uint8_t* dst, const int rows, const int cols);
+void verticalHaarRow(const int16_t* ptr1, const int16_t* ptr2, int16_t* loptr, int16_t* hiptr,
+                     const int cols);
 
 /**
- * Function which computes horizontal lifting.
+ * Function which computes horizontal lifting of a single-channel row.
  *
- * NB: pointers only from CV_16S matrices are accepted.
+ * Odd last element is copied as is.
  *
- * @param src Pointer to source matrix obtained from cv::Mat::data.
- * @param dst Destination pointer.
- * @param rows Number of rows.
+ * @param src Source row.
+ * @param dst Destination row.
  * @param cols Number of columns.
  */
-void horizontalHaar(const uint8_t* src, uint8_t* dst, int rows, int cols);
+void horizontalHaarRow(const int16_t* src, int16_t* dst, const int cols);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,155 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// AVX2 Haar kernels. This file is compiled with AVX2 enabled and is only called after
+// the dispatcher has checked that the CPU supports it.
+
+// imagestego headers
+#include "haar_common.h"
+
+// SIMD headers
+#include <immintrin.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static IMAGESTEGO_INLINE int align32(const int num) {
+    return num & ~0x1f;
+}
+
+static IMAGESTEGO_INLINE int align16(const int num) {
+    return num & ~0xf;
+}
+
+void verticalHaarRowAvx2(const int16_t* IMAGESTEGO_RESTRICT ptr1,
+        const int16_t* IMAGESTEGO_RESTRICT ptr2, int16_t* IMAGESTEGO_RESTRICT loptr,
+        int16_t* IMAGESTEGO_RESTRICT hiptr, const int cols) {
+    const int aligned = align16(cols);
+    for (int col = 0; col != aligned; col += 16) {
+#if IMAGESTEGO_GCC || IMAGESTEGO_CLANG || IMAGESTEGO_ICC
+        asm(
+            "vmovdqu (%[a], %[col], 2), %%ymm0 \n\t"
+            "vmovdqu (%[b], %[col], 2), %%ymm1 \n\t"
+            "vpaddw  %%ymm1, %%ymm0, %%ymm2    \n\t"
+            "vpsraw  $0x1, %%ymm2, %%ymm2      \n\t"
+            "vpsubw  %%ymm1, %%ymm0, %%ymm0    \n\t"
+            "vmovdqu %%ymm2, (%[lo], %[col], 2)\n\t"
+            "vmovdqu %%ymm0, (%[hi], %[col], 2)\n\t"
+            :
+            : [lo]  "r" (loptr),
+              [hi]  "r" (hiptr),
+              [a]   "r" (ptr1),
+              [b]   "r" (ptr2),
+              [col] "r" ((ptrdiff_t) col)
+            : "%ymm0", "%ymm1", "%ymm2", "memory"
+        );
+#else
+        const __m256i a = _mm256_loadu_si256((const __m256i*) (ptr1 + col)),
+                      b = _mm256_loadu_si256((const __m256i*) (ptr2 + col));
+        const __m256i lo = _mm256_srai_epi16(_mm256_add_epi16(a, b), 1),
+                      hi = _mm256_sub_epi16(a, b);
+        _mm256_storeu_si256((__m256i*) (loptr + col), lo);
+        _mm256_storeu_si256((__m256i*) (hiptr + col), hi);
+#endif
+    }
+    verticalHaarTail(ptr1, ptr2, loptr, hiptr, aligned, cols);
+}
+
+void horizontalHaarRowAvx2(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, const int cols) {
+    const __m256i mask = _mm256_set_epi32(5, 4, 1, 0, 7, 6, 3, 2);
+    const int aligned = align32(cols);
+    for (int col = 0; col != aligned; col += 32) {
+        int16_t* tmp1 = dptr + col / 2, * tmp2 = tmp1 + cols / 2;
+#if IMAGESTEGO_GCC || IMAGESTEGO_CLANG || IMAGESTEGO_ICC
+        asm(
+            "vmovdqu (%[src], %[col], 2), %%ymm0  \n\t"
+            "vmovdqu 32(%[src], %[col], 2), %%ymm1\n\t"
+            "vphsubw %%ymm0, %%ymm1, %%ymm2       \n\t"
+            "vphaddw %%ymm0, %%ymm1, %%ymm1       \n\t"
+            "vpsraw  $0x1, %%ymm1, %%ymm1         \n\t"
+            "vpermd  %%ymm1, %[mask], %%ymm1      \n\t"
+            "vpermd  %%ymm2, %[mask], %%ymm2      \n\t"
+            "vmovdqu %%ymm1, (%[lo])              \n\t"
+            "vmovdqu %%ymm2, (%[hi])              \n\t"
+            :
+            : [lo]   "r" (tmp1),
+              [hi]   "r" (tmp2),
+              [src]  "r" (sptr),
+              [mask] "x" (mask),
+              [col]  "r" ((ptrdiff_t) col)
+            : "%ymm0", "%ymm1", "%ymm2", "memory"
+        );
+#else // MSVC doesn't support inline asm for x64
+        const __m256i a = _mm256_loadu_si256((const __m256i*) (sptr + col)),
+                      b = _mm256_loadu_si256((const __m256i*) (sptr + col + 16));
+        const __m256i lo = _mm256_srai_epi16(_mm256_hadd_epi16(b, a), 1),
+                      hi = _mm256_hsub_epi16(b, a);
+        _mm256_storeu_si256((__m256i*) tmp1, _mm256_permutevar8x32_epi32(lo, mask));
+        _mm256_storeu_si256((__m256i*) tmp2, _mm256_permutevar8x32_epi32(hi, mask));
+#endif
+    }
+    horizontalHaarTail(sptr, dptr, aligned, cols);
+}
+
+void inverseVerticalHaarRowAvx2(const int16_t* IMAGESTEGO_RESTRICT loptr,
+        const int16_t* IMAGESTEGO_RESTRICT hiptr, int16_t* IMAGESTEGO_RESTRICT ptr1,
+        int16_t* IMAGESTEGO_RESTRICT ptr2, const int cols) {
+    int col;
+    for (col = 0; col + 16 <= cols; col += 16) {
+        const __m256i lo = _mm256_loadu_si256((const __m256i*) (loptr + col)),
+                      hi = _mm256_loadu_si256((const __m256i*) (hiptr + col));
+        const __m256i b = _mm256_sub_epi16(lo, _mm256_srai_epi16(hi, 1)),
+                      a = _mm256_add_epi16(b, hi);
+        _mm256_storeu_si256((__m256i*) (ptr1 + col), a);
+        _mm256_storeu_si256((__m256i*) (ptr2 + col), b);
+    }
+    inverseVerticalTail(loptr, hiptr, ptr1, ptr2, col, cols);
+}
+
+void inverseHorizontalHaarRowAvx2(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, const int cols) {
+    const int half = cols / 2;
+    int col;
+    for (col = 0; col + 16 <= half; col += 16) {
+        const __m256i lo = _mm256_loadu_si256((const __m256i*) (sptr + col)),
+                      hi = _mm256_loadu_si256((const __m256i*) (sptr + col + half));
+        const __m256i b = _mm256_sub_epi16(lo, _mm256_srai_epi16(hi, 1)),
+                      a = _mm256_add_epi16(b, hi);
+        // unpack works within 128-bit lanes, so lanes are reordered afterwards
+        const __m256i t1 = _mm256_unpacklo_epi16(a, b),
+                      t2 = _mm256_unpackhi_epi16(a, b);
+        _mm256_storeu_si256((__m256i*) (dptr + 2 * col),
+                            _mm256_permute2x128_si256(t1, t2, 0x20));
+        _mm256_storeu_si256((__m256i*) (dptr + 2 * col + 16),
+                            _mm256_permute2x128_si256(t1, t2, 0x31));
+    }
+    inverseHorizontalTail(sptr, dptr, col, cols);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// AVX512BW Haar kernels. This file is compiled with AVX512BW enabled and is only called
+// after the dispatcher has checked that the CPU supports it. Forward horizontal step has
+// no AVX512 version, the AVX2 one is used instead.
+
+// imagestego headers
+#include "haar_common.h"
+
+// SIMD headers
+#include <immintrin.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static IMAGESTEGO_INLINE int align32(const int num) {
+    return num & ~0x1f;
+}
+
+void verticalHaarRowAvx512(const int16_t* IMAGESTEGO_RESTRICT ptr1,
+        const int16_t* IMAGESTEGO_RESTRICT ptr2, int16_t* IMAGESTEGO_RESTRICT loptr,
+        int16_t* IMAGESTEGO_RESTRICT hiptr, const int cols) {
+    const int aligned = align32(cols);
+    for (int col = 0; col != aligned; col += 32) {
+        const __m512i a = _mm512_loadu_si512((const void*) (ptr1 + col)),
+                      b = _mm512_loadu_si512((const void*) (ptr2 + col));
+        const __m512i lo = _mm512_srai_epi16(_mm512_add_epi16(a, b), 1),
+                      hi = _mm512_sub_epi16(a, b);
+        _mm512_storeu_si512((void*) (loptr + col), lo);
+        _mm512_storeu_si512((void*) (hiptr + col), hi);
+    }
+    if (aligned != cols) {
+        const __mmask32 mask = (__mmask32) ((1ull << (cols - aligned)) - 1);
+        const __m512i a = _mm512_maskz_loadu_epi16(mask, ptr1 + aligned),
+                      b = _mm512_maskz_loadu_epi16(mask, ptr2 + aligned);
+        const __m512i lo = _mm512_srai_epi16(_mm512_add_epi16(a, b), 1),
+                      hi = _mm512_sub_epi16(a, b);
+        _mm512_mask_storeu_epi16(loptr + aligned, mask, lo);
+        _mm512_mask_storeu_epi16(hiptr + aligned, mask, hi);
+    }
+}
+
+void inverseVerticalHaarRowAvx512(const int16_t* IMAGESTEGO_RESTRICT loptr,
+        const int16_t* IMAGESTEGO_RESTRICT hiptr, int16_t* IMAGESTEGO_RESTRICT ptr1,
+        int16_t* IMAGESTEGO_RESTRICT ptr2, const int cols) {
+    int col;
+    for (col = 0; col + 32 <= cols; col += 32) {
+        const __m512i lo = _mm512_loadu_si512((const void*) (loptr + col)),
+                      hi = _mm512_loadu_si512((const void*) (hiptr + col));
+        const __m512i b = _mm512_sub_epi16(lo, _mm512_srai_epi16(hi, 1)),
+                      a = _mm512_add_epi16(b, hi);
+        _mm512_storeu_si512((void*) (ptr1 + col), a);
+        _mm512_storeu_si512((void*) (ptr2 + col), b);
+    }
+    if (col != cols) {
+        const __mmask32 mask = (__mmask32) ((1ull << (cols - col)) - 1);
+        const __m512i lo = _mm512_maskz_loadu_epi16(mask, loptr + col),
+                      hi = _mm512_maskz_loadu_epi16(mask, hiptr + col);
+        const __m512i b = _mm512_sub_epi16(lo, _mm512_srai_epi16(hi, 1)),
+                      a = _mm512_add_epi16(b, hi);
+        _mm512_mask_storeu_epi16(ptr1 + col, mask, a);
+        _mm512_mask_storeu_epi16(ptr2 + col, mask, b);
+    }
+}
+
+void inverseHorizontalHaarRowAvx512(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, const int cols) {
+    // interleaving indices: a0 b0 a1 b1 ... for lower and upper halves
+    const __m512i idx1 = _mm512_set_epi16(47, 15, 46, 14, 45, 13, 44, 12,
+                                          43, 11, 42, 10, 41, 9, 40, 8,
+                                          39, 7, 38, 6, 37, 5, 36, 4,
+                                          35, 3, 34, 2, 33, 1, 32, 0);
+    const __m512i idx2 = _mm512_set_epi16(63, 31, 62, 30, 61, 29, 60, 28,
+                                          59, 27, 58, 26, 57, 25, 56, 24,
+                                          55, 23, 54, 22, 53, 21, 52, 20,
+                                          51, 19, 50, 18, 49, 17, 48, 16);
+    const int half = cols / 2;
+    int col;
+    for (col = 0; col + 32 <= half; col += 32) {
+        const __m512i lo = _mm512_loadu_si512((const void*) (sptr + col)),
+                      hi = _mm512_loadu_si512((const void*) (sptr + col + half));
+        const __m512i b = _mm512_sub_epi16(lo, _mm512_srai_epi16(hi, 1)),
+                      a = _mm512_add_epi16(b, hi);
+        _mm512_storeu_si512((void*) (dptr + 2 * col), _mm512_permutex2var_epi16(a, idx1, b));
+        _mm512_storeu_si512((void*) (dptr + 2 * col + 32),
+                            _mm512_permutex2var_epi16(a, idx2, b));
+    }
+    inverseHorizontalTail(sptr, dptr, col, cols);
+}
+
+#ifdef __cplusplus
+}
+#endif
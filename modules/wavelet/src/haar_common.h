@@ -0,0 +1,93 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __IMAGESTEGO_WAVELET_PRIVATE_HAAR_COMMON_H_INCLUDED__
+#define __IMAGESTEGO_WAVELET_PRIVATE_HAAR_COMMON_H_INCLUDED__
+
+/*
+ * Scalar helpers shared by ISA-specific Haar kernels. Vector kernels use them for
+ * row tails and odd last column.
+ *
+ * Forward step: lo = floor((a + b) / 2), hi = a - b.
+ * Inverse step: b = lo - floor(hi / 2), a = b + hi.
+ */
+
+// c headers
+#include <stddef.h>
+#include <stdint.h>
+
+static IMAGESTEGO_INLINE int16_t floor2(int16_t num) {
+    return (num < 0) ? (num - 1) / 2 : num / 2;
+}
+
+// forward step for columns [col, cols) of a row pair
+static IMAGESTEGO_INLINE void verticalHaarTail(const int16_t* IMAGESTEGO_RESTRICT ptr1,
+        const int16_t* IMAGESTEGO_RESTRICT ptr2, int16_t* IMAGESTEGO_RESTRICT loptr,
+        int16_t* IMAGESTEGO_RESTRICT hiptr, int col, const int cols) {
+    for (; col < cols; ++col) {
+        loptr[col] = floor2(ptr1[col] + ptr2[col]);
+        hiptr[col] = ptr1[col] - ptr2[col];
+    }
+}
+
+// forward step for source columns [col, cols) of a row
+static IMAGESTEGO_INLINE void horizontalHaarTail(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, int col, const int cols) {
+    for (; col < cols - 1; col += 2) {
+        dptr[col / 2] = floor2(sptr[col + 1] + sptr[col]);
+        dptr[cols / 2 + col / 2] = sptr[col] - sptr[col + 1];
+    }
+    if (cols % 2 != 0) {
+        dptr[cols - 1] = sptr[cols - 1];
+    }
+}
+
+static IMAGESTEGO_INLINE void inverseStep(const int16_t lo, const int16_t hi,
+        int16_t* IMAGESTEGO_RESTRICT a, int16_t* IMAGESTEGO_RESTRICT b) {
+    *b = lo - floor2(hi);
+    *a = *b + hi;
+}
+
+// inverse step for columns [col, cols) of a row pair
+static IMAGESTEGO_INLINE void inverseVerticalTail(const int16_t* IMAGESTEGO_RESTRICT loptr,
+        const int16_t* IMAGESTEGO_RESTRICT hiptr, int16_t* IMAGESTEGO_RESTRICT ptr1,
+        int16_t* IMAGESTEGO_RESTRICT ptr2, int col, const int cols) {
+    for (; col < cols; ++col) {
+        inverseStep(loptr[col], hiptr[col], ptr1 + col, ptr2 + col);
+    }
+}
+
+// inverse step for coefficients [col, cols / 2) of a row
+static IMAGESTEGO_INLINE void inverseHorizontalTail(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, int col, const int cols) {
+    const int half = cols / 2;
+    for (; col < half; ++col) {
+        inverseStep(sptr[col], sptr[col + half], dptr + 2 * col, dptr + 2 * col + 1);
+    }
+    if (cols % 2 != 0) {
+        dptr[cols - 1] = sptr[cols - 1];
+    }
+}
+
+#endif /* __IMAGESTEGO_WAVELET_PRIVATE_HAAR_COMMON_H_INCLUDED__ */
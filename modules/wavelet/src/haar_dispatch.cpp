@@ -0,0 +1,182 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "haar.hpp"
+#include "haar_kernels.hpp"
+#include "inverse_haar.hpp"
+#include "imagestego/core/cpu.hpp"
+#include "imagestego/wavelet/backend.hpp"
+// c++ headers
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace imagestego {
+
+namespace impl {
+
+namespace {
+
+typedef void (*VerticalKernel)(const int16_t*, const int16_t*, int16_t*, int16_t*, int);
+typedef void (*HorizontalKernel)(const int16_t*, int16_t*, int);
+
+struct HaarKernels {
+    HaarBackend backend;
+    VerticalKernel vertical;
+    HorizontalKernel horizontal;
+    VerticalKernel inverseVertical;
+    HorizontalKernel inverseHorizontal;
+};
+
+// ordered from the slowest to the fastest
+const HaarKernels kernels[] = {
+    {HaarBackend::Scalar, verticalHaarRowScalar, horizontalHaarRowScalar,
+     inverseVerticalHaarRowScalar, inverseHorizontalHaarRowScalar},
+#if IMAGESTEGO_SSSE3_SUPPORTED
+    {HaarBackend::Sse, verticalHaarRowSse, horizontalHaarRowSse, inverseVerticalHaarRowSse,
+     inverseHorizontalHaarRowSse},
+#endif
+#if IMAGESTEGO_AVX2_SUPPORTED
+    {HaarBackend::Avx2, verticalHaarRowAvx2, horizontalHaarRowAvx2, inverseVerticalHaarRowAvx2,
+     inverseHorizontalHaarRowAvx2},
+#endif
+#if IMAGESTEGO_AVX512BW_SUPPORTED && IMAGESTEGO_AVX2_SUPPORTED
+    {HaarBackend::Avx512, verticalHaarRowAvx512, horizontalHaarRowAvx2,
+     inverseVerticalHaarRowAvx512, inverseHorizontalHaarRowAvx512},
+#endif
+#if IMAGESTEGO_NEON_SUPPORTED
+    {HaarBackend::Neon, verticalHaarRowNeon, horizontalHaarRowNeon, inverseVerticalHaarRowNeon,
+     inverseHorizontalHaarRowNeon},
+#endif
+};
+
+bool isSupported(HaarBackend backend) noexcept {
+    switch (backend) {
+        case HaarBackend::Scalar:
+            return true;
+        case HaarBackend::Sse:
+            return cpuSupports(CpuFeature::SSE2)
+                && cpuSupports(CpuFeature::SSSE3);
+        case HaarBackend::Avx2:
+            return cpuSupports(CpuFeature::AVX2);
+        case HaarBackend::Avx512:
+            return cpuSupports(CpuFeature::AVX2)
+                && cpuSupports(CpuFeature::AVX512BW);
+        case HaarBackend::Neon:
+            return cpuSupports(CpuFeature::NEON);
+    }
+    return false;
+}
+
+const HaarKernels* find(HaarBackend backend) noexcept {
+    for (const auto& k : kernels) {
+        if (k.backend == backend) {
+            return isSupported(backend) ? &k : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+const HaarKernels* detect() noexcept {
+    for (size_t i = std::extent<decltype(kernels)>::value; i != 0; --i) {
+        if (isSupported(kernels[i - 1].backend)) {
+            return &kernels[i - 1];
+        }
+    }
+    return kernels;
+}
+
+std::atomic<const HaarKernels*>& current() noexcept {
+    static std::atomic<const HaarKernels*> ptr(detect());
+    return ptr;
+}
+
+} // namespace
+
+} // namespace impl
+
+HaarBackend haarBackend() noexcept {
+    return impl::current().load(std::memory_order_relaxed)->backend;
+}
+
+bool isHaarBackendAvailable(HaarBackend backend) noexcept {
+    return impl::find(backend) != nullptr;
+}
+
+bool setHaarBackend(HaarBackend backend) noexcept {
+    const impl::HaarKernels* k = impl::find(backend);
+    if (!k) {
+        return false;
+    }
+    impl::current().store(k, std::memory_order_relaxed);
+    return true;
+}
+
+void resetHaarBackend() noexcept {
+    impl::current().store(impl::detect(), std::memory_order_relaxed);
+}
+
+const char* haarBackendName(HaarBackend backend) noexcept {
+    switch (backend) {
+        case HaarBackend::Scalar:
+            return "scalar";
+        case HaarBackend::Sse:
+            return "sse";
+        case HaarBackend::Avx2:
+            return "avx2";
+        case HaarBackend::Avx512:
+            return "avx512";
+        case HaarBackend::Neon:
+            return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace imagestego
+
+extern "C" {
+
+void verticalHaarRow(const int16_t* ptr1, const int16_t* ptr2, int16_t* loptr, int16_t* hiptr,
+                     const int cols) {
+    imagestego::impl::current().load(std::memory_order_relaxed)->vertical(ptr1, ptr2, loptr, hiptr,
+                                                                          cols);
+}
+
+void horizontalHaarRow(const int16_t* src, int16_t* dst, const int cols) {
+    imagestego::impl::current().load(std::memory_order_relaxed)->horizontal(src, dst, cols);
+}
+
+void inverseVerticalHaarRow(const int16_t* loptr, const int16_t* hiptr, int16_t* ptr1,
+                            int16_t* ptr2, const int cols) {
+    imagestego::impl::current().load(std::memory_order_relaxed)->inverseVertical(loptr, hiptr,
+                                                                                 ptr1, ptr2, cols);
+}
+
+void inverseHorizontalHaarRow(const int16_t* src, int16_t* dst, const int cols) {
+    imagestego::impl::current().load(std::memory_order_relaxed)->inverseHorizontal(src, dst, cols);
+}
+
+} // extern "C"
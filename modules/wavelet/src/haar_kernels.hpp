@@ -0,0 +1,86 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __IMAGESTEGO_WAVELET_PRIVATE_HAAR_KERNELS_HPP_INCLUDED__
+#define __IMAGESTEGO_WAVELET_PRIVATE_HAAR_KERNELS_HPP_INCLUDED__
+
+// c headers
+#include <cstdint>
+
+/*
+ * ISA-specific Haar row kernels. Each group is compiled with its own target flags, so it
+ * must only be called after runtime CPU check. Signatures match verticalHaarRow() and
+ * friends.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void verticalHaarRowScalar(const int16_t* ptr1, const int16_t* ptr2, int16_t* loptr,
+        int16_t* hiptr, int cols);
+void horizontalHaarRowScalar(const int16_t* src, int16_t* dst, int cols);
+void inverseVerticalHaarRowScalar(const int16_t* loptr, const int16_t* hiptr, int16_t* ptr1,
+        int16_t* ptr2, int cols);
+void inverseHorizontalHaarRowScalar(const int16_t* src, int16_t* dst, int cols);
+
+#if IMAGESTEGO_SSSE3_SUPPORTED
+void verticalHaarRowSse(const int16_t* ptr1, const int16_t* ptr2, int16_t* loptr,
+        int16_t* hiptr, int cols);
+void horizontalHaarRowSse(const int16_t* src, int16_t* dst, int cols);
+void inverseVerticalHaarRowSse(const int16_t* loptr, const int16_t* hiptr, int16_t* ptr1,
+        int16_t* ptr2, int cols);
+void inverseHorizontalHaarRowSse(const int16_t* src, int16_t* dst, int cols);
+#endif
+
+#if IMAGESTEGO_AVX2_SUPPORTED
+void verticalHaarRowAvx2(const int16_t* ptr1, const int16_t* ptr2, int16_t* loptr,
+        int16_t* hiptr, int cols);
+void horizontalHaarRowAvx2(const int16_t* src, int16_t* dst, int cols);
+void inverseVerticalHaarRowAvx2(const int16_t* loptr, const int16_t* hiptr, int16_t* ptr1,
+        int16_t* ptr2, int cols);
+void inverseHorizontalHaarRowAvx2(const int16_t* src, int16_t* dst, int cols);
+#endif
+
+#if IMAGESTEGO_AVX512BW_SUPPORTED
+void verticalHaarRowAvx512(const int16_t* ptr1, const int16_t* ptr2, int16_t* loptr,
+        int16_t* hiptr, int cols);
+void inverseVerticalHaarRowAvx512(const int16_t* loptr, const int16_t* hiptr, int16_t* ptr1,
+        int16_t* ptr2, int cols);
+void inverseHorizontalHaarRowAvx512(const int16_t* src, int16_t* dst, int cols);
+#endif
+
+#if IMAGESTEGO_NEON_SUPPORTED
+void verticalHaarRowNeon(const int16_t* ptr1, const int16_t* ptr2, int16_t* loptr,
+        int16_t* hiptr, int cols);
+void horizontalHaarRowNeon(const int16_t* src, int16_t* dst, int cols);
+void inverseVerticalHaarRowNeon(const int16_t* loptr, const int16_t* hiptr, int16_t* ptr1,
+        int16_t* ptr2, int cols);
+void inverseHorizontalHaarRowNeon(const int16_t* src, int16_t* dst, int cols);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IMAGESTEGO_WAVELET_PRIVATE_HAAR_KERNELS_HPP_INCLUDED__ */
@@ -0,0 +1,112 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// NEON Haar kernels.
+
+// imagestego headers
+#include "haar_common.h"
+
+// SIMD headers
+#include <arm_neon.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static IMAGESTEGO_INLINE int align16(const int num) {
+    return num & ~0xf;
+}
+
+static IMAGESTEGO_INLINE int align8(const int num) {
+    return num & ~0x7;
+}
+
+void verticalHaarRowNeon(const int16_t* IMAGESTEGO_RESTRICT ptr1,
+        const int16_t* IMAGESTEGO_RESTRICT ptr2, int16_t* IMAGESTEGO_RESTRICT loptr,
+        int16_t* IMAGESTEGO_RESTRICT hiptr, const int cols) {
+    const int aligned = align8(cols);
+    for (int col = 0; col != aligned; col += 8) {
+        const int16x8_t a = vld1q_s16(ptr1 + col),
+                        b = vld1q_s16(ptr2 + col);
+        const int16x8_t lo = vhaddq_s16(a, b),
+                        hi = vsubq_s16(a, b);
+        vst1q_s16(loptr + col, lo);
+        vst1q_s16(hiptr + col, hi);
+    }
+    verticalHaarTail(ptr1, ptr2, loptr, hiptr, aligned, cols);
+}
+
+void horizontalHaarRowNeon(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, const int cols) {
+    const int aligned = align16(cols);
+    for (int col = 0; col != aligned; col += 16) {
+        const int16x8_t a = vld1q_s16(sptr + col),
+                        b = vld1q_s16(sptr + col + 8);
+        const int16x8_t lo = vshrq_n_s16(vpaddq_s16(a, b), 1);
+        const int32x4_t tmp1 = vreinterpretq_s32_s16(a),
+                        tmp2 = vreinterpretq_s32_s16(b);
+        const int16x8_t t1 = vcombine_s16(vmovn_s32(tmp1), vmovn_s32(tmp2)),
+                        t2 = vcombine_s16(vshrn_n_s32(tmp1, 16), vshrn_n_s32(tmp2, 16));
+        const int16x8_t hi = vsubq_s16(t1, t2);
+        vst1q_s16(dptr + col / 2, lo);
+        vst1q_s16(dptr + col / 2 + cols / 2, hi);
+    }
+    horizontalHaarTail(sptr, dptr, aligned, cols);
+}
+
+void inverseVerticalHaarRowNeon(const int16_t* IMAGESTEGO_RESTRICT loptr,
+        const int16_t* IMAGESTEGO_RESTRICT hiptr, int16_t* IMAGESTEGO_RESTRICT ptr1,
+        int16_t* IMAGESTEGO_RESTRICT ptr2, const int cols) {
+    int col;
+    for (col = 0; col + 8 <= cols; col += 8) {
+        const int16x8_t lo = vld1q_s16(loptr + col),
+                        hi = vld1q_s16(hiptr + col);
+        const int16x8_t b = vsubq_s16(lo, vshrq_n_s16(hi, 1)),
+                        a = vaddq_s16(b, hi);
+        vst1q_s16(ptr1 + col, a);
+        vst1q_s16(ptr2 + col, b);
+    }
+    inverseVerticalTail(loptr, hiptr, ptr1, ptr2, col, cols);
+}
+
+void inverseHorizontalHaarRowNeon(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, const int cols) {
+    const int half = cols / 2;
+    int col;
+    for (col = 0; col + 8 <= half; col += 8) {
+        const int16x8_t lo = vld1q_s16(sptr + col),
+                        hi = vld1q_s16(sptr + col + half);
+        int16x8x2_t res;
+        res.val[1] = vsubq_s16(lo, vshrq_n_s16(hi, 1));
+        res.val[0] = vaddq_s16(res.val[1], hi);
+        // interleaving store: a0 b0 a1 b1 ...
+        vst2q_s16(dptr + 2 * col, res);
+    }
+    inverseHorizontalTail(sptr, dptr, col, cols);
+}
+
+#ifdef __cplusplus
+}
+#endif
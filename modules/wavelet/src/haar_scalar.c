@@ -0,0 +1,58 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Portable Haar kernels used when no SIMD extension is available.
+
+// imagestego headers
+#include "haar_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void horizontalHaarRowScalar(const int16_t* IMAGESTEGO_RESTRICT src,
+        int16_t* IMAGESTEGO_RESTRICT dst, const int cols) {
+    horizontalHaarTail(src, dst, 0, cols);
+}
+
+void verticalHaarRowScalar(const int16_t* IMAGESTEGO_RESTRICT ptr1,
+        const int16_t* IMAGESTEGO_RESTRICT ptr2, int16_t* IMAGESTEGO_RESTRICT loptr,
+        int16_t* IMAGESTEGO_RESTRICT hiptr, const int cols) {
+    verticalHaarTail(ptr1, ptr2, loptr, hiptr, 0, cols);
+}
+
+void inverseHorizontalHaarRowScalar(const int16_t* IMAGESTEGO_RESTRICT src,
+        int16_t* IMAGESTEGO_RESTRICT dst, const int cols) {
+    inverseHorizontalTail(src, dst, 0, cols);
+}
+
+void inverseVerticalHaarRowScalar(const int16_t* IMAGESTEGO_RESTRICT loptr,
+        const int16_t* IMAGESTEGO_RESTRICT hiptr, int16_t* IMAGESTEGO_RESTRICT ptr1,
+        int16_t* IMAGESTEGO_RESTRICT ptr2, const int cols) {
+    inverseVerticalTail(loptr, hiptr, ptr1, ptr2, 0, cols);
+}
+
+#ifdef __cplusplus
+}
+#endif
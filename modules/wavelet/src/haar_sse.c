@@ -0,0 +1,147 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// SSE2/SSSE3 Haar kernels. This file is compiled with SSSE3 enabled and is only called
+// after the dispatcher has checked that the CPU supports it.
+
+// imagestego headers
+#include "haar_common.h"
+
+// SIMD headers
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static IMAGESTEGO_INLINE int align16(const int num) {
+    return num & ~0xf;
+}
+
+static IMAGESTEGO_INLINE int align8(const int num) {
+    return num & ~0x7;
+}
+
+void horizontalHaarRowSse(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, const int cols) {
+    const int aligned = align16(cols);
+    for (int col = 0; col != aligned; col += 16) {
+        int16_t* tmp1 = dptr + col / 2, * tmp2 = tmp1 + cols / 2;
+#if IMAGESTEGO_GCC || IMAGESTEGO_CLANG || (IMAGESTEGO_ICC && !IMAGESTEGO_WIN)
+        asm(
+            "movdqu (%[src], %[col], 2), %%xmm0  \n\t"
+            "movdqu 16(%[src], %[col], 2), %%xmm1\n\t"
+            "movaps %%xmm0, %%xmm2               \n\t"
+            "phsubw %%xmm1, %%xmm2               \n\t"
+            "phaddw %%xmm1, %%xmm0               \n\t"
+            "psraw  $0x1, %%xmm0                 \n\t"
+            "movdqu %%xmm0, (%[lo])              \n\t"
+            "movdqu %%xmm2, (%[hi])              \n\t"
+            :
+            : [lo]  "r" (tmp1),
+              [hi]  "r" (tmp2),
+              [src] "r" (sptr),
+              [col] "r" ((ptrdiff_t) col)
+            : "%xmm0", "%xmm1", "%xmm2", "memory"
+        );
+#else
+        const __m128i a = _mm_loadu_si128((const __m128i*) (sptr + col)),
+                      b = _mm_loadu_si128((const __m128i*) (sptr + col + 8));
+        _mm_storeu_si128((__m128i*) tmp1, _mm_srai_epi16(_mm_hadd_epi16(a, b), 1));
+        _mm_storeu_si128((__m128i*) tmp2, _mm_hsub_epi16(a, b));
+#endif
+    }
+    horizontalHaarTail(sptr, dptr, aligned, cols);
+}
+
+void verticalHaarRowSse(const int16_t* IMAGESTEGO_RESTRICT ptr1,
+        const int16_t* IMAGESTEGO_RESTRICT ptr2, int16_t* IMAGESTEGO_RESTRICT loptr,
+        int16_t* IMAGESTEGO_RESTRICT hiptr, const int cols) {
+    const int aligned = align8(cols);
+    for (int col = 0; col != aligned; col += 8) {
+#if IMAGESTEGO_GCC || IMAGESTEGO_CLANG || (IMAGESTEGO_ICC && !IMAGESTEGO_WIN)
+        asm(
+            "movdqu (%[a], %[col], 2), %%xmm0 \n\t"
+            "movdqu (%[b], %[col], 2), %%xmm1 \n\t"
+            "movaps %%xmm0, %%xmm2            \n\t"
+            "paddw  %%xmm1, %%xmm2            \n\t"
+            "psraw  $0x1, %%xmm2              \n\t"
+            "psubw  %%xmm1, %%xmm0            \n\t"
+            "movdqu %%xmm2, (%[lo], %[col], 2)\n\t"
+            "movdqu %%xmm0, (%[hi], %[col], 2)\n\t"
+            :
+            : [lo]  "r" (loptr),
+              [hi]  "r" (hiptr),
+              [a]   "r" (ptr1),
+              [b]   "r" (ptr2),
+              [col] "r" ((ptrdiff_t) col)
+            : "%xmm0", "%xmm1", "%xmm2", "memory"
+        );
+#else
+        const __m128i a = _mm_loadu_si128((const __m128i*) (ptr1 + col)),
+                      b = _mm_loadu_si128((const __m128i*) (ptr2 + col));
+        const __m128i lo = _mm_srai_epi16(_mm_add_epi16(a, b), 1),
+                      hi = _mm_sub_epi16(a, b);
+        _mm_storeu_si128((__m128i*) (loptr + col), lo);
+        _mm_storeu_si128((__m128i*) (hiptr + col), hi);
+#endif
+    }
+    verticalHaarTail(ptr1, ptr2, loptr, hiptr, aligned, cols);
+}
+
+void inverseHorizontalHaarRowSse(const int16_t* IMAGESTEGO_RESTRICT sptr,
+        int16_t* IMAGESTEGO_RESTRICT dptr, const int cols) {
+    const int half = cols / 2;
+    int col;
+    for (col = 0; col + 8 <= half; col += 8) {
+        const __m128i lo = _mm_loadu_si128((const __m128i*) (sptr + col)),
+                      hi = _mm_loadu_si128((const __m128i*) (sptr + col + half));
+        const __m128i b = _mm_sub_epi16(lo, _mm_srai_epi16(hi, 1)),
+                      a = _mm_add_epi16(b, hi);
+        _mm_storeu_si128((__m128i*) (dptr + 2 * col), _mm_unpacklo_epi16(a, b));
+        _mm_storeu_si128((__m128i*) (dptr + 2 * col + 8), _mm_unpackhi_epi16(a, b));
+    }
+    inverseHorizontalTail(sptr, dptr, col, cols);
+}
+
+void inverseVerticalHaarRowSse(const int16_t* IMAGESTEGO_RESTRICT loptr,
+        const int16_t* IMAGESTEGO_RESTRICT hiptr, int16_t* IMAGESTEGO_RESTRICT ptr1,
+        int16_t* IMAGESTEGO_RESTRICT ptr2, const int cols) {
+    int col;
+    for (col = 0; col + 8 <= cols; col += 8) {
+        const __m128i lo = _mm_loadu_si128((const __m128i*) (loptr + col)),
+                      hi = _mm_loadu_si128((const __m128i*) (hiptr + col));
+        const __m128i b = _mm_sub_epi16(lo, _mm_srai_epi16(hi, 1)),
+                      a = _mm_add_epi16(b, hi);
+        _mm_storeu_si128((__m128i*) (ptr1 + col), a);
+        _mm_storeu_si128((__m128i*) (ptr2 + col), b);
+    }
+    inverseVerticalTail(loptr, hiptr, ptr1, ptr2, col, cols);
+}
+
+#ifdef __cplusplus
+}
+#endif
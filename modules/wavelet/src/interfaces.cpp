@@ -0,0 +1,126 @@
+/*
+ * This file is a part of imagestego library.
+ *
+ * Copyright (c) 2020-2021 Dmitry Kalinin <x.shreddered.x@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// imagestego headers
+#include "imagestego/wavelet/interfaces.hpp"
+#include "imagestego/core/exception.hpp"
+// opencv headers
+#include <opencv2/core.hpp>
+
+namespace imagestego {
+
+namespace {
+
+// size of LL subband after given number of levels
+cv::Size approximationSize(cv::Size size, int level) noexcept {
+    for (; level > 0; --level) {
+        size.width /= 2;
+        size.height /= 2;
+    }
+    return size;
+}
+
+void checkLevels(const cv::Size& size, int levels) {
+    const cv::Size ll = approximationSize(size, levels);
+    if (levels < 1 || ll.width == 0 || ll.height == 0) {
+        throw Exception(Exception::Codes::InvalidWaveletLevel);
+    }
+}
+
+} // namespace
+
+cv::Rect subbandRect(const cv::Size& size, int level, Subband band) {
+    if (level < 1) {
+        return cv::Rect();
+    }
+    const cv::Size ll = approximationSize(size, level);
+    switch (band) {
+        case Subband::LL:
+            return cv::Rect(0, 0, ll.width, ll.height);
+        case Subband::HL:
+            return cv::Rect(ll.width, 0, ll.width, ll.height);
+        case Subband::LH:
+            return cv::Rect(0, ll.height, ll.width, ll.height);
+        case Subband::HH:
+            return cv::Rect(ll.width, ll.height, ll.width, ll.height);
+    }
+    return cv::Rect();
+}
+
+void Wavelet::transformTo(const cv::Mat& src, cv::Mat& dst) {
+    if (dst.size() != src.size() || dst.type() != CV_MAKETYPE(CV_16S, src.channels()) ||
+        dst.data == src.data) {
+        dst = transform(src);
+    } else {
+        transform(src).copyTo(dst);
+    }
+}
+
+cv::Mat Wavelet::decompose(const cv::Mat& src, int levels) {
+    checkLevels(src.size(), levels);
+    cv::Mat dst = transform(src), buf;
+    for (int level = 1; level != levels; ++level) {
+        cv::Mat roi = dst(subbandRect(src.size(), level, Subband::LL));
+        // the first LL is the largest one, deeper levels reuse its top-left corner
+        if (buf.empty()) {
+            buf.create(roi.size(), roi.type());
+        }
+        cv::Mat tmp = buf(cv::Rect(0, 0, roi.cols, roi.rows));
+        transformTo(roi, tmp);
+        tmp.copyTo(roi);
+    }
+    return dst;
+}
+
+void Wavelet::inverseTo(const cv::Mat& src, cv::Mat& dst) {
+    if (dst.size() != src.size() || dst.channels() != src.channels() || dst.data == src.data) {
+        dst = inverse(src);
+    } else {
+        inverse(src).convertTo(dst, dst.depth());
+    }
+}
+
+cv::Mat Wavelet::reconstruct(const cv::Mat& src, int levels) {
+    // reconstructTo() consumes its input
+    cv::Mat dst, tmp = levels > 1 ? src.clone() : src;
+    reconstructTo(tmp, levels, dst);
+    return dst;
+}
+
+void Wavelet::reconstructTo(cv::Mat& src, int levels, cv::Mat& dst) {
+    checkLevels(src.size(), levels);
+    cv::Mat buf;
+    if (levels > 1) {
+        buf.create(subbandRect(src.size(), 1, Subband::LL).size(), src.type());
+    }
+    for (int level = levels - 1; level != 0; --level) {
+        cv::Mat roi = src(subbandRect(src.size(), level, Subband::LL));
+        cv::Mat tmp = buf(cv::Rect(0, 0, roi.cols, roi.rows));
+        inverseTo(roi, tmp);
+        tmp.copyTo(roi);
+    }
+    inverseTo(src, dst);
+}
+
+} // namespace imagestego
@@ -32,29 +32,29 @@ extern "C" {
 #endif
 
 /**
- * Function which computes inverse vertical lifting.
+ * Function which computes inverse vertical lifting of a row pair.
  *
- * NB: pointers only from CV_16S matrices are accepted.
+ * Rows may be interleaved, every element is treated independently.
  *
- * @param src Pointer to source matrix obtained from cv::Mat::data.
- * @param dst Destination pointer.
- * @param rows Number of rows.
- * @param cols Number of columns.
+ * @param loptr Row of low-pass coefficients.
+ * @param hiptr Row of high-pass coefficients.
+ * @param ptr1 Even destination row.
+ * @param ptr2 Odd destination row.
+ * @param cols Number of elements in a row.
  */
-void inverseVerticalHaar(const uint8_t* src, uint8_t* dst, const int rows,
-                           const int cols);
+void inverseVerticalHaarRow(const int16_t* loptr, const int16_t* hiptr, int16_t* ptr1,
+                            int16_t* ptr2, const int cols);
 
 /**
- * Function which computes inverse horizontal lifting.
+ * Function which computes inverse horizontal lifting of a single-channel row.
  *
- * NB: pointers only from CV_16S matrices are accepted.
+ * Odd last element is copied as is.
  *
- * @param src Pointer to source matrix obtained from cv::Mat::data.
- * @param dst Destination pointer.
- * @param rows Number of rows.
+ * @param src Source row.
+ * @param dst Destination row.
  * @param cols Number of columns.
  */
-void inverseHorizontalHaar(const uint8_t* src, uint8_t* dst, int rows, int cols);
+void inverseHorizontalHaarRow(const int16_t* src, int16_t* dst, const int cols);
 
 #ifdef __cplusplus
 }
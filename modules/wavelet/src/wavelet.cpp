@@ -37,31 +37,88 @@ namespace imagestego {
 
 namespace impl {
 
-cv::Rect selectRect(const cv::Mat& src, std::mt19937& gen,
-                    std::size_t minRectArea) {
-    int x0, y0, x1, y1;
-    do {
-        auto x = std::minmax({gen() % src.cols, gen() % src.cols}),
-             y = std::minmax({gen() % src.rows, gen() % src.rows});
-        x0 = x.first;
-        x1 = x.second;
-        y0 = y.first;
-        y1 = y.second;
-        // NOLINTNEXTLINE
-    } while ((x1 - x0) * (y1 - y0) < minRectArea && !(y0 == 0 && x0 >= 0 && x0 <= 11));
-    return cv::Rect(cv::Point(x0, y0), cv::Point(x1, y1));
+namespace {
+
+void checkImage(const cv::Mat& image) {
+    if (image.type() != CV_8UC3)
+        throw Exception(Exception::Codes::InvalidImageType);
+}
+
+/**
+ * Number of rows holding message size, it's stored in the first 32 channels.
+ */
+int headerRows(const cv::Size& size) noexcept {
+    return (32 + 3 * size.width - 1) / (3 * size.width);
+}
+
+/**
+ * Largest rectangle carrying the message, it lies below message size.
+ */
+cv::Size maxRect(const cv::Size& size) noexcept {
+    if (size.width <= 0 || size.height <= 0)
+        return cv::Size();
+    return cv::Size(std::max(size.width - 1, 0),
+                    std::max(size.height - headerRows(size), 0));
+}
+
+/**
+ * Checks whether rectangle of given size carries bits, i.e. its area is at least
+ * bits << (2 * level) and subband is large enough.
+ */
+bool fits(const cv::Size& rect, std::size_t bits, int level, Subband band) noexcept {
+    if (level >= 32)
+        return false;
+    const cv::Rect sub = subbandRect(rect, level, band);
+    const std::size_t area = static_cast<std::size_t>(rect.area());
+    return !sub.empty() && (area >> (2 * level)) >= bits &&
+           3 * static_cast<std::size_t>(sub.area()) >= bits;
+}
+
+/**
+ * Selects rectangle carrying bits. Its size is drawn first among the ones which fit,
+ * so any message accepted by capacity() is embedded completely.
+ */
+cv::Rect selectRect(const cv::Size& size, std::mt19937& gen, std::size_t bits, int level,
+                    Subband band) {
+    const cv::Size max = maxRect(size);
+    if (!fits(max, bits, level, band))
+        throw Exception(Exception::Codes::BigMessageSize);
+    // uniform value in [0, n]
+    auto draw = [&gen](int n) { return static_cast<int>(gen() % (n + 1u)); };
+    int width = max.width, height = max.height;
+    while (fits(cv::Size(width - 1, max.height), bits, level, band))
+        --width;
+    width += draw(max.width - width);
+    while (fits(cv::Size(width, height - 1), bits, level, band))
+        --height;
+    height += draw(max.height - height);
+    const int x = draw(size.width - width), y = headerRows(size) + draw(max.height - height);
+    return cv::Rect(x, y, width, height);
 }
 
+} // namespace
+
 class WaveletEmbedder {
 public:
     explicit WaveletEmbedder(Wavelet* wavelet, Encoder* encoder)
-        : _encoder(encoder), _wavelet(wavelet) {}
+        : _encoder(encoder), _wavelet(wavelet), _level(1), _band(Subband::HH) {}
     virtual ~WaveletEmbedder() noexcept {
         delete _wavelet;
         if (_encoder)
             delete _encoder;
     }
     void setImage(const std::string& src) { _image = cv::imread(src); }
+    void setImage(const std::vector<uint8_t>& buf) {
+        _image = cv::imdecode(buf, cv::IMREAD_COLOR);
+    }
+    void setImage(const cv::Mat& image) {
+        checkImage(image);
+        _image = image.clone();
+    }
+    void setImage(cv::Mat& image) {
+        checkImage(image);
+        _image = image;
+    }
     void setMessage(const std::string& msg) {
         if (_encoder) {
             _encoder->setMessage(msg);
@@ -73,14 +130,38 @@ public:
     void setSecretKey(const std::string& key) {
         _prng.seed(imagestego::hash(key));
     }
+    void setLevel(int level) {
+        if (level < 1) {
+            throw Exception(Exception::Codes::InvalidWaveletLevel);
+        }
+        _level = level;
+    }
+    void setSubband(Subband band) noexcept { _band = band; }
     void createStegoContainer(const std::string& dst) {
+        embed();
+        cv::imwrite(dst, _image);
+    }
+    void createStegoContainer(std::vector<uint8_t>& dst, const std::string& ext) {
+        embed();
+        cv::imencode(ext, _image, dst);
+    }
+    void createStegoContainer(cv::Mat& dst) {
+        embed();
+        dst = _image;
+    }
+
+private:
+    void embed() {
+        // selected before writing anything, so too long message leaves image intact
+        const cv::Rect rect =
+            selectRect(_image.size(), _prng, _arr.size(), _level, _band);
         std::size_t idx = 0;
-        imagestego::BitArray size = imagestego::BitArray::fromInt(_arr.size());
+        const uint32_t size = static_cast<uint32_t>(_arr.size());
         for (int row = 0; row < _image.rows && idx < 32; ++row) {
             for (int col = 0; col < _image.cols && idx < 32; ++col) {
                 auto p = _image.at<cv::Vec3b>(row, col);
                 for (int color = 0; color < 3 && idx < 32; ++color) {
-                    if (size[idx]) {
+                    if ((size >> (31 - idx)) & 1u) {
                         p.val[color] |= 1;
                     } else {
                         p.val[color] &= ~1u;
@@ -90,14 +171,17 @@ public:
                 _image.at<cv::Vec3b>(row, col) = p;
             }
         }
-        auto rect = selectRect(_image, _prng, _arr.size() * 4);
-        cv::Mat transformed = _wavelet->transform(_image(rect));
+        cv::Mat transformed = _wavelet->decompose(_image(rect), _level);
+        const cv::Rect band = subbandRect(transformed.size(), _level, _band);
         idx = 0;
-        for (int row = transformed.rows / 2; row < transformed.rows && idx < _arr.size(); ++row) {
-            for (int col = transformed.cols / 2; col < transformed.cols && idx < _arr.size(); ++col) {
+        uint64_t word = 0;
+        for (int row = band.y; row < band.y + band.height && idx < _arr.size(); ++row) {
+            for (int col = band.x; col < band.x + band.width && idx < _arr.size(); ++col) {
                 auto p = transformed.at<cv::Vec3s>(row, col);
                 for (int color = 0; color != 3 && idx < _arr.size(); ++color) {
-                    if (_arr[idx]) {
+                    if (idx % 64 == 0)
+                        word = _arr.readBits(idx, 64);
+                    if ((word >> (63 - idx % 64)) & 1u) {
                         p.val[color] |= 1;
                     } else {
                         p.val[color] &= ~1u;
@@ -107,22 +191,24 @@ public:
                 transformed.at<cv::Vec3s>(row, col) = p;
             }
         }
-        _wavelet->inverse(transformed).copyTo(_image(rect));
-        cv::imwrite(dst, _image);
+        // last level is saturated straight into the 8-bit roi
+        cv::Mat roi = _image(rect);
+        _wavelet->reconstructTo(transformed, _level, roi);
     }
 
-private:
     cv::Mat _image;
     imagestego::BitArray _arr;
     std::mt19937 _prng;
     Encoder* _encoder;
     Wavelet* _wavelet;
+    int _level;
+    Subband _band;
 }; // class WaveletEmbedder
 
 class WaveletExtracter {
 public:
     explicit WaveletExtracter(Wavelet* wavelet, Decoder* decoder)
-        : _wavelet(wavelet), _decoder(decoder) {}
+        : _wavelet(wavelet), _decoder(decoder), _level(1), _band(Subband::HH) {}
     virtual ~WaveletExtracter() noexcept {
         delete _wavelet;
         if (_decoder)
@@ -131,34 +217,51 @@ public:
     void setImage(const std::string& src) {
         _image = cv::imread(src);
     }
+    void setImage(const std::vector<uint8_t>& buf) {
+        _image = cv::imdecode(buf, cv::IMREAD_COLOR);
+    }
+    void setImage(const cv::Mat& image) {
+        checkImage(image);
+        _image = image;
+    }
     void setSecretKey(const std::string& key) {
         _prng.seed(imagestego::hash(key));
     }
+    void setLevel(int level) {
+        if (level < 1) {
+            throw Exception(Exception::Codes::InvalidWaveletLevel);
+        }
+        _level = level;
+    }
+    void setSubband(Subband band) noexcept { _band = band; }
     std::string extractMessage() {
-        imagestego::BitArray msg, _size;
-        std::size_t idx = 0;
+        imagestego::BitArray msg;
+        std::size_t idx = 0, size = 0;
         for (int row = 0; row < _image.rows && idx < 32; ++row) {
             for (int col = 0; col < _image.cols && idx < 32; ++col) {
                 auto p = _image.at<cv::Vec3b>(row, col);
                 for (int color = 0; color != 3 && idx < 32; ++color) {
-                    _size.pushBack((p.val[color] & 1) != 0);
+                    size = (size << 1) | (p.val[color] & 1u);
                     ++idx;
                 }
             }
         }
-        std::size_t size = _size.toInt();
         idx = 0;
-        auto rect = selectRect(_image, _prng, size * 4);
-        cv::Mat transformed = _wavelet->transform(_image(rect));
-        for (int row = transformed.rows / 2; row < transformed.rows && idx < size; ++row) {
-            for (int col = transformed.cols / 2; col < transformed.cols && idx < size; ++col) {
+        uint64_t word = 0;
+        const cv::Rect rect = selectRect(_image.size(), _prng, size, _level, _band);
+        cv::Mat transformed = _wavelet->decompose(_image(rect), _level);
+        const cv::Rect band = subbandRect(transformed.size(), _level, _band);
+        for (int row = band.y; row < band.y + band.height && idx < size; ++row) {
+            for (int col = band.x; col < band.x + band.width && idx < size; ++col) {
                 auto p = transformed.at<cv::Vec3s>(row, col);
                 for (int color = 0; color != 3 && idx < size; ++color) {
-                    msg.pushBack((p.val[color] & 1) != 0);
-                    ++idx;
+                    word = (word << 1) | (p.val[color] & 1u);
+                    if (++idx % 64 == 0)
+                        msg.appendBits(word, 64);
                 }
             }
         }
+        msg.appendBits(word, idx % 64);
         if (_decoder) {
             _decoder->setMessage(msg);
             return _decoder->getDecodedMessage();
@@ -171,6 +274,8 @@ private:
     cv::Mat _image;
     Wavelet* _wavelet;
     Decoder* _decoder;
+    int _level;
+    Subband _band;
 }; // class WaveletExtracter
 
 } // namespace impl
@@ -185,14 +290,46 @@ WaveletEmbedder::~WaveletEmbedder() noexcept {
 
 void WaveletEmbedder::setImage(const std::string& src) { _pImpl->setImage(src); }
 
+void WaveletEmbedder::setImage(const std::vector<uint8_t>& buf) { _pImpl->setImage(buf); }
+
+void WaveletEmbedder::setImage(const cv::Mat& image) { _pImpl->setImage(image); }
+
+void WaveletEmbedder::setImage(cv::Mat& image) { _pImpl->setImage(image); }
+
 void WaveletEmbedder::setMessage(const std::string& msg) { _pImpl->setMessage(msg); }
 
 void WaveletEmbedder::setSecretKey(const std::string& key) { _pImpl->setSecretKey(key); }
 
+void WaveletEmbedder::setLevel(int level) { _pImpl->setLevel(level); }
+
+void WaveletEmbedder::setSubband(Subband band) { _pImpl->setSubband(band); }
+
 void WaveletEmbedder::createStegoContainer(const std::string& dst) {
     _pImpl->createStegoContainer(dst);
 }
 
+void WaveletEmbedder::createStegoContainer(std::vector<uint8_t>& dst,
+                                           const std::string& ext) {
+    _pImpl->createStegoContainer(dst, ext);
+}
+
+void WaveletEmbedder::createStegoContainer(cv::Mat& dst) {
+    _pImpl->createStegoContainer(dst);
+}
+
+std::size_t WaveletEmbedder::capacity(const cv::Size& size, int level, Subband band) {
+    if (level < 1)
+        throw Exception(Exception::Codes::InvalidWaveletLevel);
+    const cv::Size rect = impl::maxRect(size);
+    if (!impl::fits(rect, 0, level, band))
+        return 0;
+    // the largest rectangle carries the most, see impl::fits()
+    const std::size_t byArea = static_cast<std::size_t>(rect.area()) >> (2 * level);
+    const std::size_t bySubband =
+        3 * static_cast<std::size_t>(subbandRect(rect, level, band).area());
+    return std::min(byArea, bySubband);
+}
+
 WaveletExtracter::WaveletExtracter(Wavelet* wavelet, Decoder* decoder)
     : _pImpl(new impl::WaveletExtracter(wavelet, decoder)) {}
 
@@ -203,10 +340,18 @@ WaveletExtracter::~WaveletExtracter() noexcept {
 
 void WaveletExtracter::setImage(const std::string& src) { _pImpl->setImage(src); }
 
+void WaveletExtracter::setImage(const std::vector<uint8_t>& buf) { _pImpl->setImage(buf); }
+
+void WaveletExtracter::setImage(const cv::Mat& image) { _pImpl->setImage(image); }
+
 void WaveletExtracter::setSecretKey(const std::string& key) {
     _pImpl->setSecretKey(key);
 }
 
+void WaveletExtracter::setLevel(int level) { _pImpl->setLevel(level); }
+
+void WaveletExtracter::setSubband(Subband band) { _pImpl->setSubband(band); }
+
 std::string WaveletExtracter::extractMessage() {
     return _pImpl->extractMessage();
 }
@@ -27,6 +27,7 @@
 // c++ headers
 #include <algorithm>
 #include <iostream>
+#include <vector>
 // gtest
 #include <gtest/gtest.h>
 // opencv headers
@@ -56,3 +57,201 @@ TEST(Wavelet, InverseVectorHaar) {
     std::cout << std::hex << "inverse(v): " << exp << std::endl
         << "inverse:    " << actual << std::endl;
 }
+
+TEST(Wavelet, InverseHaarMatchesReference) {
+    imagestego::HaarWavelet w1;
+    imagestego::experimental::HaarWavelet w2;
+    const int sizes[][2] = {{1, 32}, {2, 2}, {7, 9}, {16, 64}, {33, 71}, {64, 130}};
+    for (const auto& size : sizes) {
+        cv::Mat m(size[0], size[1], CV_16SC3);
+        cv::randu(m, cv::Scalar(-255, -255, -255), cv::Scalar(255, 255, 255));
+        const cv::Mat expected = w1.inverse(m), actual = w2.inverse(m);
+        EXPECT_EQ(cv::norm(expected, actual, cv::NORM_INF), 0)
+            << size[0] << "x" << size[1];
+    }
+}
+
+TEST(Wavelet, HaarMatchesExperimental) {
+    imagestego::HaarWavelet w1;
+    imagestego::experimental::HaarWavelet w2;
+    const int sizes[][2] = {{1, 32}, {2, 2}, {7, 9}, {16, 64}, {33, 71}, {64, 130}};
+    for (const auto& size : sizes) {
+        cv::Mat m(size[0], size[1], CV_16SC3);
+        cv::randu(m, cv::Scalar(-255, -255, -255), cv::Scalar(255, 255, 255));
+        EXPECT_EQ(cv::norm(w1.transform(m), w2.transform(m), cv::NORM_INF), 0)
+            << size[0] << "x" << size[1];
+    }
+}
+
+TEST(Wavelet, HaarRoundTrip) {
+    imagestego::HaarWavelet wavelet;
+    cv::Mat m(45, 83, CV_8UC3), expected;
+    cv::randu(m, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+    m.convertTo(expected, CV_16S);
+    const cv::Mat actual = wavelet.inverse(wavelet.transform(m));
+    EXPECT_EQ(cv::norm(expected, actual, cv::NORM_INF), 0);
+}
+
+TEST(Wavelet, ExperimentalHaarRoundTrip) {
+    imagestego::experimental::HaarWavelet wavelet;
+    cv::Mat m(45, 83, CV_8UC3), expected;
+    cv::randu(m, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+    m.convertTo(expected, CV_16S);
+    const cv::Mat actual = wavelet.inverse(wavelet.transform(m));
+    EXPECT_EQ(cv::norm(expected, actual, cv::NORM_INF), 0);
+}
+
+TEST(Wavelet, HaarInterleavedMatchesPlanes) {
+    imagestego::HaarWavelet w1;
+    imagestego::experimental::HaarWavelet w2;
+    imagestego::Wavelet* wavelets[] = {&w1, &w2};
+    // large enough to be split into several bands
+    cv::Mat m(517, 301, CV_16SC3);
+    cv::randu(m, cv::Scalar(-255, -255, -255), cv::Scalar(255, 255, 255));
+    std::vector<cv::Mat> planes;
+    cv::split(m, planes);
+    for (auto* wavelet : wavelets) {
+        std::vector<cv::Mat> forward, backward;
+        for (const auto& plane : planes) {
+            forward.push_back(wavelet->transform(plane));
+            backward.push_back(wavelet->inverse(plane));
+        }
+        cv::Mat expected;
+        cv::merge(forward, expected);
+        EXPECT_EQ(cv::norm(expected, wavelet->transform(m), cv::NORM_INF), 0);
+        cv::merge(backward, expected);
+        EXPECT_EQ(cv::norm(expected, wavelet->inverse(m), cv::NORM_INF), 0);
+        // non-continuous input
+        const cv::Mat roi = m(cv::Rect(3, 5, 200, 311));
+        EXPECT_EQ(cv::norm(roi, wavelet->inverse(wavelet->transform(roi)), cv::NORM_INF), 0);
+    }
+}
+
+TEST(Wavelet, HaarEightBit) {
+    imagestego::HaarWavelet w1;
+    imagestego::experimental::HaarWavelet w2;
+    imagestego::Wavelet* wavelets[] = {&w1, &w2};
+    cv::Mat m(517, 301, CV_8UC3), wide;
+    cv::randu(m, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+    m.convertTo(wide, CV_16S);
+    for (auto* wavelet : wavelets) {
+        const cv::Mat coeffs = wavelet->transform(m);
+        EXPECT_EQ(coeffs.type(), CV_16SC3);
+        EXPECT_EQ(cv::norm(wavelet->transform(wide), coeffs, cv::NORM_INF), 0);
+        // restored straight into 8-bit roi of a bigger image
+        cv::Mat image(600, 400, CV_8UC3, cv::Scalar(0, 0, 0));
+        cv::Mat roi = image(cv::Rect(10, 20, m.cols, m.rows));
+        const uint8_t* data = roi.data;
+        wavelet->inverseTo(coeffs, roi);
+        EXPECT_EQ(roi.data, data);
+        EXPECT_EQ(cv::norm(m, roi, cv::NORM_INF), 0);
+        // out of range values are saturated
+        cv::Mat shifted = wide.clone(), expected;
+        for (int row = 0; row != shifted.rows; ++row) {
+            for (int col = 0; col != shifted.cols; ++col) {
+                shifted.at<cv::Vec3s>(row, col)[0] -= 128;
+                shifted.at<cv::Vec3s>(row, col)[1] += 128;
+            }
+        }
+        shifted.convertTo(expected, CV_8U);
+        cv::Mat actual(m.size(), CV_8UC3);
+        wavelet->inverseTo(wavelet->transform(shifted), actual);
+        EXPECT_EQ(cv::norm(expected, actual, cv::NORM_INF), 0);
+    }
+}
+
+TEST(Wavelet, HaarBackendsMatchScalar) {
+    using imagestego::HaarBackend;
+    const HaarBackend backends[] = {HaarBackend::Sse, HaarBackend::Avx2, HaarBackend::Avx512,
+                                    HaarBackend::Neon};
+    const int sizes[][2] = {{1, 32}, {2, 2}, {7, 9}, {16, 64}, {33, 71}, {64, 130}};
+    imagestego::HaarWavelet reference;
+    imagestego::experimental::HaarWavelet wavelet;
+    for (const auto& size : sizes) {
+        cv::Mat m(size[0], size[1], CV_16SC3);
+        cv::randu(m, cv::Scalar(-255, -255, -255), cv::Scalar(255, 255, 255));
+        ASSERT_TRUE(imagestego::setHaarBackend(HaarBackend::Scalar));
+        const cv::Mat expected = wavelet.transform(m);
+        EXPECT_EQ(cv::norm(reference.inverse(m), wavelet.inverse(m), cv::NORM_INF), 0);
+        for (const auto backend : backends) {
+            if (!imagestego::setHaarBackend(backend)) {
+                continue;
+            }
+            EXPECT_EQ(cv::norm(expected, wavelet.transform(m), cv::NORM_INF), 0)
+                << imagestego::haarBackendName(backend) << " " << size[0] << "x" << size[1];
+            EXPECT_EQ(cv::norm(reference.inverse(m), wavelet.inverse(m), cv::NORM_INF), 0)
+                << imagestego::haarBackendName(backend) << " " << size[0] << "x" << size[1];
+        }
+    }
+    imagestego::resetHaarBackend();
+}
+
+TEST(Wavelet, HaarBackendSelection) {
+    using imagestego::HaarBackend;
+    const HaarBackend detected = imagestego::haarBackend();
+    EXPECT_TRUE(imagestego::isHaarBackendAvailable(detected));
+    EXPECT_TRUE(imagestego::isHaarBackendAvailable(HaarBackend::Scalar));
+    EXPECT_TRUE(imagestego::setHaarBackend(HaarBackend::Scalar));
+    EXPECT_EQ(imagestego::haarBackend(), HaarBackend::Scalar);
+    EXPECT_STREQ(imagestego::haarBackendName(HaarBackend::Scalar), "scalar");
+    for (const auto backend : {HaarBackend::Sse, HaarBackend::Avx2, HaarBackend::Avx512,
+                               HaarBackend::Neon}) {
+        EXPECT_EQ(imagestego::setHaarBackend(backend),
+                  imagestego::isHaarBackendAvailable(backend));
+    }
+    imagestego::resetHaarBackend();
+    EXPECT_EQ(imagestego::haarBackend(), detected);
+}
+
+TEST(Wavelet, SubbandRect) {
+    const cv::Size size(13, 10);
+    EXPECT_EQ(imagestego::subbandRect(size, 1, imagestego::Subband::LL), cv::Rect(0, 0, 6, 5));
+    EXPECT_EQ(imagestego::subbandRect(size, 1, imagestego::Subband::HL), cv::Rect(6, 0, 6, 5));
+    EXPECT_EQ(imagestego::subbandRect(size, 1, imagestego::Subband::LH), cv::Rect(0, 5, 6, 5));
+    EXPECT_EQ(imagestego::subbandRect(size, 1, imagestego::Subband::HH), cv::Rect(6, 5, 6, 5));
+    EXPECT_EQ(imagestego::subbandRect(size, 2, imagestego::Subband::HH), cv::Rect(3, 2, 3, 2));
+    EXPECT_EQ(imagestego::subbandRect(size, 0, imagestego::Subband::LL), cv::Rect());
+}
+
+TEST(Wavelet, HaarDecompose) {
+    imagestego::HaarWavelet reference;
+    imagestego::experimental::HaarWavelet wavelet;
+    cv::Mat m(45, 83, CV_8UC3), expected;
+    cv::randu(m, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+    m.convertTo(expected, CV_16S);
+    // second level is the first one applied to LL subband
+    cv::Mat manual = reference.transform(m);
+    cv::Mat ll = manual(imagestego::subbandRect(m.size(), 1, imagestego::Subband::LL));
+    reference.transform(ll).copyTo(ll);
+    EXPECT_EQ(cv::norm(manual, reference.decompose(m, 2), cv::NORM_INF), 0);
+    for (int levels = 1; levels != 5; ++levels) {
+        const cv::Mat decomposed = wavelet.decompose(m, levels);
+        EXPECT_EQ(cv::norm(decomposed, reference.decompose(m, levels), cv::NORM_INF), 0)
+            << levels;
+        EXPECT_EQ(cv::norm(expected, wavelet.reconstruct(decomposed, levels), cv::NORM_INF), 0)
+            << levels;
+        // consumed copy restored straight into 8-bit roi
+        cv::Mat tmp = decomposed.clone(), image(m.rows + 2, m.cols + 3, CV_8UC3);
+        cv::Mat roi = image(cv::Rect(3, 2, m.cols, m.rows));
+        const uint8_t* data = roi.data;
+        wavelet.reconstructTo(tmp, levels, roi);
+        EXPECT_EQ(roi.data, data);
+        EXPECT_EQ(cv::norm(m, roi, cv::NORM_INF), 0) << levels;
+    }
+    // transform into roi of a scratch buffer
+    cv::Mat buf(m.rows + 1, m.cols + 1, CV_16SC3);
+    cv::Mat roi = buf(cv::Rect(1, 1, m.cols, m.rows));
+    const uint8_t* data = roi.data;
+    wavelet.transformTo(m, roi);
+    EXPECT_EQ(roi.data, data);
+    EXPECT_EQ(cv::norm(roi, reference.transform(m), cv::NORM_INF), 0);
+}
+
+TEST(Wavelet, HaarDecomposeTooDeep) {
+    imagestego::HaarWavelet wavelet;
+    cv::Mat m(7, 9, CV_16SC3, cv::Scalar(1, 2, 3));
+    EXPECT_NO_THROW(wavelet.decompose(m, 2));
+    EXPECT_THROW(wavelet.decompose(m, 3), imagestego::Exception);
+    EXPECT_THROW(wavelet.decompose(m, 0), imagestego::Exception);
+    EXPECT_THROW(wavelet.reconstruct(m, 3), imagestego::Exception);
+}
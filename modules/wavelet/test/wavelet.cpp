@@ -26,8 +26,12 @@
 #include "imagestego/algorithm/wavelet.hpp"
 #include "imagestego/compression/huffman.hpp"
 #include "imagestego/wavelet/haar.hpp"
+// opencv headers
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
 // c++ headers
 #include <iostream>
+#include <vector>
 // gtest
 #include <gtest/gtest.h>
 
@@ -58,3 +62,124 @@ TEST(Wavelet, WaveletEmbedderHuffman) {
     ext.setSecretKey("key");
     std::cout << ext.extractMessage() << std::endl;
 }
+
+TEST(Wavelet, WaveletEmbedderBuffer) {
+    std::vector<uint8_t> src, dst;
+    cv::imencode(".png", cv::imread("test.jpg"), src);
+    imagestego::WaveletEmbedder emb(new imagestego::HaarWavelet);
+    emb.setMessage("test message");
+    emb.setSecretKey("key");
+    emb.setImage(src);
+    emb.createStegoContainer(dst, ".png");
+
+    imagestego::WaveletExtracter ext(new imagestego::HaarWavelet);
+    ext.setImage(dst);
+    ext.setSecretKey("key");
+    EXPECT_EQ(ext.extractMessage(), "test message");
+}
+
+TEST(Wavelet, WaveletEmbedderMat) {
+    cv::Mat image = cv::imread("test.jpg"), dst;
+    imagestego::WaveletEmbedder emb(new imagestego::HaarWavelet);
+    emb.setMessage("test message");
+    emb.setSecretKey("key");
+    emb.setImage(image);
+    emb.createStegoContainer(dst);
+    EXPECT_EQ(dst.data, image.data);
+
+    imagestego::WaveletExtracter ext(new imagestego::HaarWavelet);
+    ext.setImage(image);
+    ext.setSecretKey("key");
+    EXPECT_EQ(ext.extractMessage(), "test message");
+}
+
+TEST(Wavelet, WaveletEmbedderLevel) {
+    const imagestego::Subband bands[] = {imagestego::Subband::HL, imagestego::Subband::LH,
+                                         imagestego::Subband::HH};
+    for (const auto band : bands) {
+        std::vector<uint8_t> dst;
+        imagestego::WaveletEmbedder emb(new imagestego::HaarWavelet);
+        emb.setLevel(2);
+        emb.setSubband(band);
+        emb.setMessage("test message");
+        emb.setSecretKey("key");
+        emb.setImage(cv::imread("test.jpg"));
+        emb.createStegoContainer(dst, ".png");
+
+        imagestego::WaveletExtracter ext(new imagestego::HaarWavelet);
+        ext.setLevel(2);
+        ext.setSubband(band);
+        ext.setImage(dst);
+        ext.setSecretKey("key");
+        EXPECT_EQ(ext.extractMessage(), "test message");
+    }
+    imagestego::WaveletEmbedder emb(new imagestego::HaarWavelet);
+    EXPECT_THROW(emb.setLevel(0), imagestego::Exception);
+}
+
+TEST(Wavelet, WaveletImageType) {
+    cv::Mat gray(16, 16, CV_8UC1, cv::Scalar::all(0)),
+        bgra(16, 16, CV_8UC4, cv::Scalar::all(0));
+    const cv::Mat& constGray = gray;
+    imagestego::WaveletEmbedder emb(new imagestego::HaarWavelet);
+    EXPECT_THROW(emb.setImage(gray), imagestego::Exception);
+    EXPECT_THROW(emb.setImage(constGray), imagestego::Exception);
+    EXPECT_THROW(emb.setImage(bgra), imagestego::Exception);
+    imagestego::WaveletExtracter ext(new imagestego::HaarWavelet);
+    EXPECT_THROW(ext.setImage(constGray), imagestego::Exception);
+}
+
+TEST(Wavelet, WaveletCapacity) {
+    using imagestego::Subband;
+    using imagestego::WaveletEmbedder;
+    EXPECT_EQ(WaveletEmbedder::capacity(cv::Size(65, 65)), 1024);
+    EXPECT_EQ(WaveletEmbedder::capacity(cv::Size(65, 65), 2, Subband::HL), 256);
+    EXPECT_EQ(WaveletEmbedder::capacity(cv::Size(12, 5)), 11);
+    // message size takes 3 rows, the rest is too small
+    EXPECT_EQ(WaveletEmbedder::capacity(cv::Size(4, 4)), 0);
+    // too small for message size
+    EXPECT_EQ(WaveletEmbedder::capacity(cv::Size(3, 3)), 0);
+    EXPECT_THROW(WaveletEmbedder::capacity(cv::Size(65, 65), 0), imagestego::Exception);
+
+    cv::Mat image(33, 33, CV_8UC3, cv::Scalar::all(128));
+    WaveletEmbedder emb(new imagestego::HaarWavelet);
+    emb.setMessage(std::string(WaveletEmbedder::capacity(image.size()) / 8 + 1, 'a'));
+    emb.setSecretKey("key");
+    emb.setImage(image);
+    EXPECT_THROW(emb.createStegoContainer(image), imagestego::Exception);
+}
+
+TEST(Wavelet, WaveletFullCapacity) {
+    using imagestego::Subband;
+    using imagestego::WaveletEmbedder;
+    const std::pair<int, Subband> params[] = {
+        {1, Subband::HH}, {2, Subband::HL}, {3, Subband::LH}};
+    cv::Mat src(65, 65, CV_8UC3);
+    cv::randu(src, cv::Scalar::all(32), cv::Scalar::all(224));
+    for (const auto& param : params) {
+        const std::size_t capacity =
+            WaveletEmbedder::capacity(src.size(), param.first, param.second);
+        ASSERT_EQ(capacity % 8, 0u);
+        std::string msg(capacity / 8, 'a');
+        for (std::size_t i = 0; i != msg.size(); ++i)
+            msg[i] = static_cast<char>('a' + i % 26);
+        // rectangle depends on the key, every one has to carry the message
+        for (const std::string key : {"key", "other key", "one more key"}) {
+            cv::Mat image = src.clone(), dst;
+            WaveletEmbedder emb(new imagestego::HaarWavelet);
+            emb.setLevel(param.first);
+            emb.setSubband(param.second);
+            emb.setMessage(msg);
+            emb.setSecretKey(key);
+            emb.setImage(image);
+            emb.createStegoContainer(dst);
+
+            imagestego::WaveletExtracter ext(new imagestego::HaarWavelet);
+            ext.setLevel(param.first);
+            ext.setSubband(param.second);
+            ext.setSecretKey(key);
+            ext.setImage(dst);
+            EXPECT_EQ(ext.extractMessage(), msg);
+        }
+    }
+}